@@ -2,6 +2,7 @@
 #define atomanip_h
 
 #include <stddef.h>
+#include <stdbool.h>
 
 /**
  * @brief Atomically add to a given number
@@ -28,4 +29,36 @@ size_t atomic_increment(volatile size_t *target);
  */
 size_t atomic_decrement(volatile size_t *target);
 
+/**
+ * @brief Atomically replace a given number if it still holds the expected value
+ * 
+ * @param target Target number to replace
+ * @param expected Value the variable has to hold
+ * @param desired Value to replace it with
+ * @return true The variable has been replaced
+ * @return false The variable held another value
+ */
+bool atomic_cas(volatile size_t *target, const size_t expected, const size_t desired);
+
+/**
+ * @brief Read a number, ordering all following reads and writes after it
+ * 
+ * @param target Target number to read
+ * @return size_t Current value of the variable
+ */
+size_t atomic_load_acquire(volatile size_t *target);
+
+/**
+ * @brief Write a number, ordering all previous reads and writes before it
+ * 
+ * @param target Target number to write
+ * @param value Value to write
+ */
+void atomic_store_release(volatile size_t *target, const size_t value);
+
+/**
+ * @brief Order all previous reads and writes before all following ones
+ */
+void atomic_fence();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,143 @@
+#ifndef bloom_h
+#define bloom_h
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "blvckstd/htable.h"
+#include "blvckstd/mman.h"
+#include "blvckstd/compattrs.h"
+
+// Number of 64-bit words per block, one block spans a single cache line
+#define BLOOM_BLOCK_WORDS 8
+#define BLOOM_BLOCK_BITS (BLOOM_BLOCK_WORDS * 64)
+
+// Bounds of bits set per key
+#define BLOOM_MIN_HASHES 1
+#define BLOOM_MAX_HASHES 16
+
+/**
+ * @brief Represents a blocked bloom filter, where all bits of a key
+ * fall into the same block and thus a query touches one cache line only
+ * 
+ * INFO: Keys can't be removed, a filter only ever answers with false positives
+ */
+typedef struct bloom
+{
+  // Cache line aligned blocks, pointing into _block_mem
+  uint64_t *blocks;
+
+  // Number of blocks
+  size_t _block_count;
+
+  // Number of bits set per key
+  size_t _num_hashes;
+
+  // Number of keys added since the last clear
+  size_t _item_count;
+
+  // Allocated block memory, one block larger than needed to allow aligning
+  void *_block_mem;
+} bloom_t;
+
+/**
+ * @brief Allocate a new, empty bloom filter
+ * 
+ * @param item_cap Number of keys the filter is sized for
+ * @param bits_per_item Number of bits per key, 10 yields about a 1% false positive rate
+ * @return bloom_t* Pointer to the new filter
+ */
+bloom_t *bloom_make(size_t item_cap, size_t bits_per_item);
+
+/**
+ * @brief Derive the block and the in-block bit positions from a key's
+ * full hash, as produced by the htable hashing functions
+ * 
+ * @param bloom Filter reference
+ * @param hash Full hash of the key
+ * @param bit Output for the first bit position
+ * @param step Output for the distance between the bit positions
+ * @return uint64_t* Block of this hash
+ */
+INLINED static uint64_t *bloom_block(bloom_t *bloom, uint64_t hash, uint32_t *bit, uint32_t *step)
+{
+  // Remix, so that the bits don't correlate with the block choice
+  uint64_t mixed = htable_hash_u64(hash);
+  *bit = (uint32_t) mixed;
+  *step = (uint32_t) (mixed >> 32) | 1;
+  return &bloom->blocks[(hash % bloom->_block_count) * BLOOM_BLOCK_WORDS];
+}
+
+/**
+ * @brief Add a key by it's full hash
+ * 
+ * @param bloom Filter reference
+ * @param hash Full hash of the key
+ */
+INLINED static void bloom_add_hash(bloom_t *bloom, uint64_t hash)
+{
+  uint32_t bit, step;
+  uint64_t *block = bloom_block(bloom, hash, &bit, &step);
+
+  for (size_t i = 0; i < bloom->_num_hashes; i++, bit += step)
+  {
+    uint32_t pos = bit % BLOOM_BLOCK_BITS;
+    block[pos / 64] |= (uint64_t) 1 << (pos % 64);
+  }
+
+  bloom->_item_count++;
+}
+
+/**
+ * @brief Check whether a key may have been added, by it's full hash
+ * 
+ * @param bloom Filter reference
+ * @param hash Full hash of the key
+ * 
+ * @return true Key may have been added
+ * @return false Key has definitely not been added
+ */
+INLINED static bool bloom_may_contain_hash(bloom_t *bloom, uint64_t hash)
+{
+  uint32_t bit, step;
+  uint64_t *block = bloom_block(bloom, hash, &bit, &step);
+
+  for (size_t i = 0; i < bloom->_num_hashes; i++, bit += step)
+  {
+    uint32_t pos = bit % BLOOM_BLOCK_BITS;
+    if (!(block[pos / 64] & ((uint64_t) 1 << (pos % 64))))
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Add a string key
+ * 
+ * @param bloom Filter reference
+ * @param key Key to add
+ */
+void bloom_add(bloom_t *bloom, const char *key);
+
+/**
+ * @brief Check whether a string key may have been added
+ * 
+ * @param bloom Filter reference
+ * @param key Key to check
+ * 
+ * @return true Key may have been added
+ * @return false Key has definitely not been added
+ */
+bool bloom_may_contain(bloom_t *bloom, const char *key);
+
+/**
+ * @brief Remove all keys from the filter
+ * 
+ * @param bloom Filter reference
+ */
+void bloom_clear(bloom_t *bloom);
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef btree_h
+#define btree_h
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "blvckstd/mman.h"
+#include "blvckstd/enumlut.h"
+#include "blvckstd/strclone.h"
+#include "blvckstd/common_types.h"
+
+// Maximum number of keys per node, nodes other than the root never drop below half of it
+#define BTREE_MAX_KEYS 32
+#define BTREE_MIN_KEYS (BTREE_MAX_KEYS / 2)
+
+// Maximum length of a key
+#define BTREE_MAX_KEYLEN 256
+
+/**
+ * @brief Represents btree operation results
+ */
+#define _EVALS_BTREE_RESULT(FUN)                                                      \
+  FUN(BTREE_SUCCESS,            0x0) /* Operation has been successful */             \
+  FUN(BTREE_KEY_NOT_FOUND,      0x1) /* The requested key couldn't be located */     \
+  FUN(BTREE_KEY_ALREADY_EXISTS, 0x2) /* The requested key already exists */          \
+  FUN(BTREE_KEY_TOO_LONG,       0x3) /* The requested key has too many characters */ \
+  FUN(BTREE_NULL_VALUE,         0x4) /* Tried to insert a null value */
+
+ENUM_TYPEDEF_FULL_IMPL(btree_result, _EVALS_BTREE_RESULT);
+
+/**
+ * @brief Represents a node of the tree, where leaves hold the values
+ * and inner nodes hold separators, which are copies of leaf keys
+ */
+typedef struct btree_node
+{
+  // Number of keys in this node
+  size_t _count;
+
+  // Whether this node holds values instead of children
+  bool _leaf;
+
+  // Sorted keys, owned by the node
+  char *keys[BTREE_MAX_KEYS];
+
+  union
+  {
+    // Values of a leaf, connected to the key at the same index
+    void *values[BTREE_MAX_KEYS];
+
+    // Children of an inner node, children[i] holds all keys below keys[i]
+    struct btree_node *children[BTREE_MAX_KEYS + 1];
+  };
+
+  // Next leaf in key order, NULL for inner nodes and the last leaf
+  struct btree_node *_next;
+} btree_node_t;
+
+/**
+ * @brief Represents an ordered map of string keys
+ */
+typedef struct
+{
+  btree_node_t *root;
+
+  // Current number of items in the tree
+  size_t _item_count;
+
+  // Cleanup function for the tree items
+  clfn_t _cf;
+} btree_t;
+
+/**
+ * @brief Represents a position within the tree's leaves as well as
+ * the bounds of a range, it's invalidated by any modification of the tree
+ */
+typedef struct
+{
+  // Current leaf and index within it
+  btree_node_t *_leaf;
+  size_t _index;
+
+  // Exclusive upper bound, NULL if unbounded
+  const char *_end;
+
+  // Prefix all keys have to start with, NULL if unbounded
+  const char *_prefix;
+  size_t _prefix_len;
+} btree_iter_t;
+
+/**
+ * @brief Allocate a new, empty tree
+ *
+ * @param cf Cleanup function for the items
+ * @return btree_t* Pointer to the new tree
+ */
+btree_t *btree_make(clfn_t cf);
+
+/**
+ * @brief Insert a new item into the tree
+ *
+ * @param tree Tree reference
+ * @param key Key to connect with the value, gets copied
+ * @param elem Pointer to the value
+ *
+ * @return btree_result_t Result of this operation
+ */
+btree_result_t btree_insert(btree_t *tree, const char *key, void *elem);
+
+/**
+ * @brief Check if the tree already contains this key
+ *
+ * @param tree Tree reference
+ * @param key Key to check
+ *
+ * @return true Key exists
+ * @return false Key does not exist
+ */
+bool btree_contains(btree_t *tree, const char *key);
+
+/**
+ * @brief Remove an element by it's key
+ *
+ * @param tree Tree reference
+ * @param key Key connected to the target value
+ *
+ * @return btree_result_t Result of this operation
+ */
+btree_result_t btree_remove(btree_t *tree, const char *key);
+
+/**
+ * @brief Get an existing key's connected value
+ *
+ * @param tree Tree reference
+ * @param key Key connected to the target value
+ * @param output Output pointer buffer
+ *
+ * @return btree_result_t Result of this operation
+ */
+btree_result_t btree_fetch(btree_t *tree, const char *key, void **output);
+
+/**
+ * @brief Get the current number of items in the tree
+ *
+ * @param tree Tree reference
+ */
+size_t btree_count(btree_t *tree);
+
+/*
+============================================================================
+                                 Iteration
+============================================================================
+*/
+
+/**
+ * @brief Position an iterator on the smallest key
+ *
+ * @param tree Tree reference
+ * @param iter Iterator to position
+ */
+void btree_first(btree_t *tree, btree_iter_t *iter);
+
+/**
+ * @brief Position an iterator on the first key not below the given key
+ *
+ * @param tree Tree reference
+ * @param key Key to search for
+ * @param iter Iterator to position
+ */
+void btree_lower_bound(btree_t *tree, const char *key, btree_iter_t *iter);
+
+/**
+ * @brief Position an iterator on the first key above the given key
+ *
+ * @param tree Tree reference
+ * @param key Key to search for
+ * @param iter Iterator to position
+ */
+void btree_upper_bound(btree_t *tree, const char *key, btree_iter_t *iter);
+
+/**
+ * @brief Position an iterator on the half-open range [from, to)
+ *
+ * @param tree Tree reference
+ * @param from Inclusive lower bound, NULL if unbounded
+ * @param to Exclusive upper bound, NULL if unbounded, has to outlive the iterator
+ * @param iter Iterator to position
+ */
+void btree_range(btree_t *tree, const char *from, const char *to, btree_iter_t *iter);
+
+/**
+ * @brief Position an iterator on all keys starting with a prefix
+ *
+ * @param tree Tree reference
+ * @param prefix Prefix to match, has to outlive the iterator
+ * @param iter Iterator to position
+ */
+void btree_prefix(btree_t *tree, const char *prefix, btree_iter_t *iter);
+
+/**
+ * @brief Yield the iterator's current item and advance it
+ *
+ * @param iter Iterator reference
+ * @param key Key output, points into the tree, leave as NULL if not needed
+ * @param value Value output, leave as NULL if not needed
+ *
+ * @return true An item has been yielded
+ * @return false The iterator reached the end of it's range
+ */
+bool btree_iter_next(btree_iter_t *iter, const char **key, void **value);
+
+#endif
@@ -3,12 +3,70 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <inttypes.h>
 
 #include "blvckstd/mman.h"
 #include "blvckstd/enumlut.h"
 #include "blvckstd/strfmt.h"
 #include "blvckstd/common_types.h"
 
+// Number of slots kept within the array struct itself, before moving to the heap
+#define DYNARR_INLINE_SLOTS 4
+
+/**
+ * @brief Used to decide by how much an array grows once it's full
+ */
+typedef enum dynarr_growth_mode
+{
+  DYNARR_GM_FACTOR,               // Multiply the size by a factor
+  DYNARR_GM_CHUNK,                // Add a fixed number of slots
+  DYNARR_GM_CUSTOM                // Ask a callback for the new size
+} dynarr_growth_mode_t;
+
+/**
+ * @brief Custom growth callback
+ * 
+ * @param array_size Current number of slots
+ * @param min_size Minimum number of slots needed
+ * @return size_t Desired number of slots, gets constrained to [min_size, cap]
+ */
+typedef size_t (*dynarr_growth_f)(size_t array_size, size_t min_size);
+
+/**
+ * @brief Growth policy of an array
+ */
+typedef struct
+{
+  dynarr_growth_mode_t mode;
+
+  union
+  {
+    double factor;
+    size_t chunk;
+    dynarr_growth_f custom;
+  };
+} dynarr_growth_t;
+
+/**
+ * @brief Compares two items, returning <0, 0 or >0 like strcmp
+ */
+typedef int (*dynarr_cmp_f)(const void *a, const void *b);
+
+/**
+ * @brief Compares a search key against an item, returning <0, 0 or >0 like strcmp
+ */
+typedef int (*dynarr_key_cmp_f)(const void *key, const void *item);
+
+/**
+ * @brief Extracts an item's integer key for radix sorting
+ */
+typedef uint64_t (*dynarr_radix_key_f)(const void *item);
+
+/**
+ * @brief Extracts an item's string key for radix sorting
+ */
+typedef const char *(*dynarr_radix_str_f)(const void *item);
+
 /**
  * @brief Represents the dynamic array, keeping track of it's
  * size and cleanup method
@@ -26,26 +84,62 @@ typedef struct
 
   // Cleanup function for the array items
   clfn_t _cf;
+
+  // Occupancy of the slots, one bit per slot
+  uint64_t *_occupied;
+
+  // Lowest index which may be free, all slots below it are occupied
+  size_t _free_hint;
+
+  // Whether items are kept packed at the front, without any holes
+  bool _dense;
+
+  // Number of items, only tracked by dense arrays
+  size_t _length;
+
+  // Policy used when growing, doubling by default
+  dynarr_growth_t _growth;
+
+  // Number of slots the first growth allocates at once, 0 once it happened
+  size_t _deferred_size;
+
+  // Slots and their occupancy while the array fits, items and _occupied point here then
+  void *_inline_items[DYNARR_INLINE_SLOTS];
+  uint64_t _inline_occupied;
 } dynarr_t;
 
 #define _EVALS_DYNARR_RES(FUN)                                                \
   FUN(DYNARR_SUCCESS,          0x0) /* Successful operation */                \
   FUN(DYNARR_INDEX_NOT_FOUND,  0x1) /* Key at requested index not existing */ \
   FUN(DYNARR_FULL,             0x2) /* No more space for more items */        \
-  FUN(DYNARR_EMPTY,            0x3) /* No more item to pop */
+  FUN(DYNARR_EMPTY,            0x3) /* No more item to pop */                 \
+  FUN(DYNARR_NULL_ITEM,        0x4) /* Dense arrays can't hold NULL items */  \
+  FUN(DYNARR_SIZE_MISMATCH,    0x5) /* Type doesn't match the element size */
 
 ENUM_TYPEDEF_FULL_IMPL(dynarr_result, _EVALS_DYNARR_RES);
 
 /**
  * @brief Make a new, empty array
  * 
- * @param array_size Size of the array
+ * @param array_size Size of the array, up to DYNARR_INLINE_SLOTS don't need a separate allocation
  * @param array_max_size Maximum size of the array, set to array_size for no automatic growth
  * @param cf Cleanup function for the items
  * @return dynarr_t* Pointer to the new array
  */
 dynarr_t *dynarr_make(size_t array_size, size_t array_max_size, clfn_t cf);
 
+/**
+ * @brief Make a new, empty array with a growth policy, which doesn't allocate
+ * any slots until the first push, that then allocates array_size slots at once
+ * 
+ * @param array_size Number of slots to allocate on the first push
+ * @param array_max_size Maximum size of the array
+ * @param cf Cleanup function for the items
+ * @param growth Policy used when growing past array_size
+ * @return dynarr_t* Pointer to the new array
+ */
+dynarr_t *dynarr_make_ex(size_t array_size, size_t array_max_size, clfn_t cf, dynarr_growth_t growth);
+
 /**
  * @brief Make a new, empty array using the mman resource deallocator
  * 
@@ -64,7 +158,67 @@ dynarr_t *dynarr_make_mm(size_t array_size, size_t array_max_size);
 dynarr_t *dynarr_make_mmf(size_t array_size);
 
 /**
- * @brief Push a new item into the array
+ * @brief Make a new, empty dense array, which keeps it's items packed at the front like a
+ * vector, so that it's length is known and removals preserve the order of the remaining items
+ * 
+ * @param array_size Initial number of slots
+ * @param array_max_size Maximum size of the array, set to array_size for no automatic growth
+ * @param cf Cleanup function for the items
+ * @return dynarr_t* Pointer to the new array
+ */
+dynarr_t *dynarr_make_dense(size_t array_size, size_t array_max_size, clfn_t cf);
+
+/**
+ * @brief Grow by multiplying the number of slots, which is the default with a factor of 2
+ * 
+ * @param arr Array reference
+ * @param factor Factor to grow by, growing by at least one slot
+ */
+void dynarr_grow_by_factor(dynarr_t *arr, double factor);
+
+/**
+ * @brief Grow by adding a fixed number of slots
+ * 
+ * @param arr Array reference
+ * @param chunk Number of slots to add, at least one
+ */
+void dynarr_grow_by_chunk(dynarr_t *arr, size_t chunk);
+
+/**
+ * @brief Grow by the size a callback decides on
+ * 
+ * @param arr Array reference
+ * @param custom Growth callback
+ */
+void dynarr_grow_custom(dynarr_t *arr, dynarr_growth_f custom);
+
+/**
+ * @brief Grow to hold at least the given number of slots, without applying the growth policy
+ * 
+ * @param arr Array reference
+ * @param num_slots Minimum number of slots
+ * @return dynarr_result_t Operation result, DYNARR_FULL if the cap doesn't allow for this size
+ */
+dynarr_result_t dynarr_reserve(dynarr_t *arr, size_t num_slots);
+
+/**
+ * @brief Give unused slots behind the last active slot back, as indices have to stay stable
+ * 
+ * @param arr Array reference
+ */
+void dynarr_shrink_to_fit(dynarr_t *arr);
+
+/**
+ * @brief Get the number of items in the array, which is O(1) for dense arrays
+ * 
+ * @param arr Array reference
+ * @return size_t Number of items
+ */
+size_t dynarr_length(dynarr_t *arr);
+
+/**
+ * @brief Push a new item into the lowest free slot of the array, growing it if there's none,
+ * which is always the slot behind the last item for dense arrays
  * 
  * @param arr Array reference
  * @param item Item to push
@@ -84,14 +238,25 @@ dynarr_result_t dynarr_push(dynarr_t *arr, void *item, size_t *slot);
 dynarr_result_t dynarr_set_at(dynarr_t *arr, size_t index, void *item);
 
 /**
- * @brief Remove an item at a specific location from the array
+ * @brief Remove an item at a specific location from the array, where
+ * dense arrays move all following items one slot to the front
  * 
  * @param arr Array reference
  * @param index Array index
+ * @param out Removed item output, set to NULL if not needed
  * @return dynarr_result_t Operation result
  */
 dynarr_result_t dynarr_remove_at(dynarr_t *arr, size_t index, void **out);
 
+/**
+ * @brief Remove the item at the highest occupied index from the array
+ * 
+ * @param arr Array reference
+ * @param out Removed item output, set to NULL if not needed
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t dynarr_pop(dynarr_t *arr, void **out);
+
 /**
  * @brief Dumps the current state of the array in a human readable format
  * 
@@ -117,6 +282,74 @@ size_t dynarr_as_array(dynarr_t *arr, void ***out);
  */
 void dynarr_clear(dynarr_t *arr);
 
+/**
+ * @brief Iterates the active slots of an array in ascending order, in place
+ * 
+ * INFO: Sparse arrays may have the current item removed while iterating,
+ * INFO: any other modification invalidates the iterator
+ */
+typedef struct
+{
+  // Index and item of the current slot, valid after dynarr_iter_next returned true
+  size_t index;
+  void *item;
+
+  dynarr_t *_arr;
+
+  // Current occupancy word and it's remaining, not yet visited bits
+  size_t _word;
+  uint64_t _bits;
+} dynarr_iter_t;
+
+/**
+ * @brief Visit all active slots of an array, exposing them through the named iterator
+ */
+#define DYNARR_FOREACH(arr, iter) \
+  for (dynarr_iter_t iter = dynarr_iter(arr); dynarr_iter_next(&iter);)
+
+/**
+ * @brief Create an iterator, positioned before the first active slot
+ * 
+ * @param arr Array to iterate
+ * @return dynarr_iter_t Iterator, no cleanup needed
+ */
+INLINED static dynarr_iter_t dynarr_iter(dynarr_t *arr)
+{
+  dynarr_iter_t iter;
+  iter.index = 0;
+  iter.item = NULL;
+  iter._arr = arr;
+  iter._word = 0;
+  iter._bits = arr->_array_size ? arr->_occupied[0] : 0;
+  return iter;
+}
+
+/**
+ * @brief Advance to the next active slot
+ * 
+ * @param iter Iterator reference
+ * @return true The iterator points at the next active slot
+ * @return false There are no more active slots
+ */
+INLINED static bool dynarr_iter_next(dynarr_iter_t *iter)
+{
+  dynarr_t *arr = iter->_arr;
+
+  // Skip exhausted words
+  size_t words = (arr->_array_size + 63) / 64;
+  while (!iter->_bits)
+  {
+    if (++iter->_word >= words) return false;
+    iter->_bits = arr->_occupied[iter->_word];
+  }
+
+  // Visit the lowest remaining bit and clear it
+  iter->index = iter->_word * 64 + __builtin_ctzll(iter->_bits);
+  iter->item = arr->items[iter->index];
+  iter->_bits &= iter->_bits - 1;
+  return true;
+}
+
 /**
  * @brief Get all active indices of a dynamic array
  * 
@@ -126,4 +359,64 @@ void dynarr_clear(dynarr_t *arr);
  */
 void dynarr_indices(dynarr_t *arr, size_t **active, size_t *num_active);
 
+/*
+============================================================================
+                                  Sorting
+============================================================================
+*/
+
+/**
+ * @brief Move all items to the front of the array, keeping their order,
+ * so that the holes end up behind the last item
+ * 
+ * @param arr Array to pack
+ * @return size_t Number of items
+ */
+size_t dynarr_pack(dynarr_t *arr);
+
+/**
+ * @brief Sort all items by introsort, which packs the array first
+ * 
+ * @param arr Array to sort
+ * @param cmp Item comparator
+ */
+void dynarr_sort(dynarr_t *arr, dynarr_cmp_f cmp);
+
+/**
+ * @brief Stably sort all items by their unsigned integer keys through an LSD radix sort,
+ * which packs the array first
+ * 
+ * @param arr Array to sort
+ * @param key Key extractor
+ */
+void dynarr_sort_radix(dynarr_t *arr, dynarr_radix_key_f key);
+
+/**
+ * @brief Sort all items by their string keys through an MSD radix sort, which packs the array first
+ * 
+ * @param arr Array to sort
+ * @param key Key extractor
+ */
+void dynarr_sort_radix_str(dynarr_t *arr, dynarr_radix_str_f key);
+
+/**
+ * @brief Sort all items by introsort on a thread pool, which packs the array first
+ * 
+ * @param arr Array to sort
+ * @param cmp Item comparator, called from multiple threads at once
+ * @param pool Pool to sort and merge the runs on, one run per thread
+ */
+void dynarr_sort_parallel(dynarr_t *arr, dynarr_cmp_f cmp, struct tpool *pool);
+
+/**
+ * @brief Binary search a sorted and thus packed array
+ * 
+ * @param arr Array to search
+ * @param key Search key
+ * @param cmp Key to item comparator
+ * @param index Index of the first item not below the key, set to NULL if not needed
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t dynarr_bsearch(dynarr_t *arr, const void *key, dynarr_key_cmp_f cmp, size_t *index);
+
 #endif
\ No newline at end of file
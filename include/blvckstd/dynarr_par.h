@@ -0,0 +1,75 @@
+#ifndef dynarr_par_h
+#define dynarr_par_h
+
+/*
+  Parallel operations over dynarr.
+
+  Slots are split into consecutive chunks which are processed on a thread pool,
+  skipping NULL holes. Results are always produced in slot order.
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "blvckstd/dynarr.h"
+#include "blvckstd/tpool.h"
+#include "blvckstd/common_types.h"
+
+/**
+ * @brief Maps an item to a new one, returning NULL to drop it
+ */
+typedef void *(*dynarr_map_f)(void *item, void *arg);
+
+/**
+ * @brief Decides whether an item is kept
+ */
+typedef bool (*dynarr_filter_f)(void *item, void *arg);
+
+/**
+ * @brief Folds an item or another accumulator into an accumulator, returning the new accumulator
+ */
+typedef void *(*dynarr_reduce_f)(void *acc, void *item, void *arg);
+
+/**
+ * @brief Creates a fresh accumulator, so that each chunk owns one of it's own
+ */
+typedef void *(*dynarr_identity_f)(void *arg);
+
+/**
+ * @brief Map all items into a new dense array on a thread pool, skipping holes and keeping the order
+ * 
+ * @param arr Array to map
+ * @param pool Pool to run on
+ * @param map Mapping function, called from multiple threads at once
+ * @param arg Argument to pass to the mapping function
+ * @param cf Cleanup function for the new array's items
+ * @return dynarr_t* New array holding all non-NULL results
+ */
+dynarr_t *dynarr_par_map(dynarr_t *arr, tpool_t *pool, dynarr_map_f map, void *arg, clfn_t cf);
+
+/**
+ * @brief Filter all items into a new dense array on a thread pool, skipping holes and keeping the order
+ * 
+ * @param arr Array to filter
+ * @param pool Pool to run on
+ * @param filter Predicate, called from multiple threads at once
+ * @param arg Argument to pass to the predicate
+ * @return dynarr_t* New array borrowing all kept items, without a cleanup function
+ */
+dynarr_t *dynarr_par_filter(dynarr_t *arr, tpool_t *pool, dynarr_filter_f filter, void *arg);
+
+/**
+ * @brief Reduce all items on a thread pool, skipping holes, where consecutive chunks are
+ * reduced independently and their accumulators are combined in order
+ * 
+ * @param arr Array to reduce
+ * @param pool Pool to run on
+ * @param make_identity Creates the initial accumulator, called once per chunk, so that accumulators may be mutated in place
+ * @param reduce Folds an item into an accumulator, called from multiple threads at once
+ * @param combine Folds a chunk's accumulator into the accumulator of all chunks before it, which takes over the former
+ * @param arg Argument to pass to all functions
+ * @return void* Final accumulator, a fresh identity if there are no chunks
+ */
+void *dynarr_par_reduce(dynarr_t *arr, tpool_t *pool, dynarr_identity_f make_identity, dynarr_reduce_f reduce, dynarr_reduce_f combine, void *arg);
+
+#endif
\ No newline at end of file
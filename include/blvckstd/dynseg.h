@@ -0,0 +1,136 @@
+#ifndef dynseg_h
+#define dynseg_h
+
+/*
+  Segmented counterpart of dynarr.
+
+  Slots live in fixed-size chunks, which are never moved once allocated, so
+  growing never copies any slots and slot addresses stay stable. Only the chunk
+  directory gets reallocated, which is smaller by the chunk size. Indices are
+  resolved in O(1) by a shift and a mask. Results are reported through
+  dynarr_result_t.
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "blvckstd/mman.h"
+#include "blvckstd/dynarr.h"
+#include "blvckstd/common_types.h"
+
+// Number of slots per chunk if not specified otherwise
+#define DYNSEG_DEFAULT_CHUNK_SLOTS 1024
+
+/**
+ * @brief Represents the segmented array, keeping track of it's
+ * chunks, size and cleanup method
+ */
+typedef struct
+{
+  // Chunk directory, each chunk holds 1 << _chunk_shift slots
+  void ***chunks;
+
+  // Number of allocated chunks and directory entries
+  size_t _chunk_count;
+  size_t _dir_size;
+
+  // Slots per chunk as a power of two
+  size_t _chunk_shift;
+
+  // Number of slots in use, holes get filled before appending behind the last one
+  size_t _array_size;
+
+  // Maximum number of slots the array can grow to
+  size_t _array_cap;
+
+  // Number of non-NULL items
+  size_t _item_count;
+
+  // Occupancy of the slots of all chunks, one bit per slot
+  uint64_t *_occupied;
+
+  // Lowest index which may be empty, all slots below it are occupied
+  size_t _free_hint;
+
+  // Cleanup function for the array items
+  clfn_t _cf;
+} dynseg_t;
+
+/**
+ * @brief Make a new, empty segmented array
+ *
+ * @param chunk_slots Slots per chunk, rounded up to a power of two, 0 for DYNSEG_DEFAULT_CHUNK_SLOTS
+ * @param array_max_size Maximum number of slots
+ * @param cf Cleanup function for the items
+ * @return dynseg_t* Pointer to the new array
+ */
+dynseg_t *dynseg_make(size_t chunk_slots, size_t array_max_size, clfn_t cf);
+
+/**
+ * @brief Get the address of a slot, which stays valid as long as the array lives
+ *
+ * @param arr Array reference
+ * @param index Array index
+ * @return void** Slot address, NULL if out of range
+ */
+INLINED static void **dynseg_slot(dynseg_t *arr, size_t index)
+{
+  if (index >= arr->_array_size) return NULL;
+
+  size_t mask = ((size_t) 1 << arr->_chunk_shift) - 1;
+  return &arr->chunks[index >> arr->_chunk_shift][index & mask];
+}
+
+/**
+ * @brief Get the item at an index
+ *
+ * @param arr Array reference
+ * @param index Array index
+ * @return void* Item, NULL if out of range or empty
+ */
+INLINED static void *dynseg_get(dynseg_t *arr, size_t index)
+{
+  void **slot = dynseg_slot(arr, index);
+  return slot ? *slot : NULL;
+}
+
+/**
+ * @brief Push an item into the lowest empty slot, otherwise append it behind
+ * the last slot, allocating a new chunk if needed
+ *
+ * @param arr Array reference
+ * @param item Item to push
+ * @param slot Slot that has been pushed to, set to NULL if not needed
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t dynseg_push(dynseg_t *arr, void *item, size_t *slot);
+
+/**
+ * @brief Set an item at a slot in use, cleaning up the old item
+ *
+ * @param arr Array reference
+ * @param index Array index
+ * @param item Item to set
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t dynseg_set_at(dynseg_t *arr, size_t index, void *item);
+
+/**
+ * @brief Remove an item, leaving it's slot empty
+ *
+ * @param arr Array reference
+ * @param index Array index
+ * @param out Removed item output, set to NULL if not needed
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t dynseg_remove_at(dynseg_t *arr, size_t index, void **out);
+
+/**
+ * @brief Get the number of non-NULL items
+ *
+ * @param arr Array reference
+ */
+size_t dynseg_length(dynseg_t *arr);
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef dynvec_h
+#define dynvec_h
+
+/*
+  Inline counterpart of dynarr.
+
+  Elements of a fixed size are copied into one contiguous block, so there's
+  neither an allocation nor a pointer per element. Vectors are always dense,
+  just like dense dynarrs, and report their results through dynarr_result_t.
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "blvckstd/mman.h"
+#include "blvckstd/dynarr.h"
+#include "blvckstd/common_types.h"
+
+/**
+ * @brief Represents the dynamic vector, keeping track of it's
+ * element size, length and cleanup method
+ */
+typedef struct
+{
+  // Contiguous elements, _elem_size bytes each
+  void *items;
+
+  // Size of an individual element in bytes
+  size_t _elem_size;
+
+  // Number of elements
+  size_t _length;
+
+  // Current allocated number of elements
+  size_t _array_size;
+
+  // Maximum number of elements the vector can grow to
+  size_t _array_cap;
+
+  // Cleanup function, invoked with a pointer to the element
+  clfn_t _cf;
+} dynvec_t;
+
+/**
+ * @brief Make a new vector for elements of a type
+ */
+#define DYNVEC_MAKE(type, array_size, array_max_size, cf) \
+  dynvec_make(sizeof(type), (array_size), (array_max_size), (cf))
+
+/**
+ * @brief Access the element at an index as a type, without any range check
+ */
+#define DYNVEC_AT(vec, type, index) \
+  (((type *) (vec)->items)[index])
+
+/**
+ * @brief Make a new, empty vector
+ *
+ * @param elem_size Size of an individual element in bytes
+ * @param array_size Initial number of elements to allocate
+ * @param array_max_size Maximum number of elements, set to array_size for no automatic growth
+ * @param cf Cleanup function for the elements, invoked with a pointer to the element
+ * @return dynvec_t* Pointer to the new vector
+ */
+dynvec_t *dynvec_make(size_t elem_size, size_t array_size, size_t array_max_size, clfn_t cf);
+
+/**
+ * @brief Get the number of elements in the vector
+ *
+ * @param vec Vector reference
+ */
+size_t dynvec_length(dynvec_t *vec);
+
+/**
+ * @brief Get a pointer to the element at an index
+ *
+ * @param vec Vector reference
+ * @param index Vector index
+ * @return void* Pointer into the vector, NULL if out of range, invalidated by growing
+ */
+void *dynvec_at(dynvec_t *vec, size_t index);
+
+/**
+ * @brief Copy a new element behind the last element
+ *
+ * @param vec Vector reference
+ * @param elem Element to copy in
+ * @param slot Index that has been pushed to, set to NULL if not needed
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t dynvec_push(dynvec_t *vec, const void *elem, size_t *slot);
+
+/**
+ * @brief Copy an element out of the vector
+ *
+ * @param vec Vector reference
+ * @param index Vector index
+ * @param out Buffer of at least the element size
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t dynvec_get(dynvec_t *vec, size_t index, void *out);
+
+/**
+ * @brief Replace an existing element, cleaning up the old one
+ *
+ * @param vec Vector reference
+ * @param index Vector index
+ * @param elem Element to copy in
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t dynvec_set_at(dynvec_t *vec, size_t index, const void *elem);
+
+/**
+ * @brief Remove an element, moving all following elements one slot to the front
+ *
+ * @param vec Vector reference
+ * @param index Vector index
+ * @param out Buffer of at least the element size for the removed element, set to NULL if not needed
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t dynvec_remove_at(dynvec_t *vec, size_t index, void *out);
+
+/**
+ * @brief Remove the last element
+ *
+ * @param vec Vector reference
+ * @param out Buffer of at least the element size for the removed element, set to NULL if not needed
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t dynvec_pop(dynvec_t *vec, void *out);
+
+/**
+ * @brief Clean up and remove all elements
+ *
+ * @param vec Vector to clear
+ */
+void dynvec_clear(dynvec_t *vec);
+
+/**
+ * @brief Keeps a template parameter from being deduced, so that the element type is always spelled out
+ */
+template <typename T>
+struct dynvec_type
+{
+  typedef T type;
+};
+
+/**
+ * @brief Push a value of the vector's element type, called as dynvec_push_val<type>(vec, value)
+ *
+ * @param vec Vector reference
+ * @param value Value to copy in, converted to the element type
+ * @return dynarr_result_t Operation result, DYNARR_SIZE_MISMATCH if the type doesn't match the element size
+ */
+template <typename T>
+dynarr_result_t dynvec_push_val(dynvec_t *vec, const typename dynvec_type<T>::type &value)
+{
+  if (sizeof(T) != vec->_elem_size) return DYNARR_SIZE_MISMATCH;
+  return dynvec_push(vec, &value, NULL);
+}
+
+/**
+ * @brief Copy an element out of the vector as the vector's element type
+ *
+ * @param vec Vector reference
+ * @param index Vector index
+ * @param out Element output
+ * @return dynarr_result_t Operation result, DYNARR_SIZE_MISMATCH if the type doesn't match the element size
+ */
+template <typename T>
+dynarr_result_t dynvec_get_val(dynvec_t *vec, size_t index, T *out)
+{
+  if (sizeof(T) != vec->_elem_size) return DYNARR_SIZE_MISMATCH;
+  return dynvec_get(vec, index, out);
+}
+
+/**
+ * @brief Replace an existing element by a value of the vector's element type,
+ * called as dynvec_set_val<type>(vec, index, value)
+ *
+ * @param vec Vector reference
+ * @param index Vector index
+ * @param value Value to copy in, converted to the element type
+ * @return dynarr_result_t Operation result, DYNARR_SIZE_MISMATCH if the type doesn't match the element size
+ */
+template <typename T>
+dynarr_result_t dynvec_set_val(dynvec_t *vec, size_t index, const typename dynvec_type<T>::type &value)
+{
+  if (sizeof(T) != vec->_elem_size) return DYNARR_SIZE_MISMATCH;
+  return dynvec_set_at(vec, index, &value);
+}
+
+#endif
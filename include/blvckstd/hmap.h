@@ -0,0 +1,383 @@
+#ifndef hmap_h
+#define hmap_h
+
+/*
+  Typed, header-only counterpart of htable.
+
+  Keys and values are stored inline within one contiguous slot array, which
+  is probed linearly, so there's neither an allocation per value nor a pointer
+  chase per lookup. Hashing and comparison are template parameters and can thus
+  be inlined by the compiler. Just like htable, a map is sized once by it's
+  item cap and reports it's results through htable_result_t.
+*/
+
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "blvckstd/htable.h"
+
+// Maximum number of items per 8 slots
+#define HMAP_LOAD_PER_8 6
+
+// Slot metadata marking an empty slot, occupied slots carry 7 bits of their hash
+#define HMAP_EMPTY 0x00
+#define HMAP_OCCUPIED 0x80
+
+namespace blvckstd
+{
+  /**
+   * @brief Default hasher, hashes the raw bytes of a key, which is only
+   * sound for keys without padding or other indeterminate bytes
+   */
+  template <typename K>
+  struct hmap_hash
+  {
+    static_assert(std::has_unique_object_representations<K>::value, "provide an hmap_hash specialization");
+
+    uint64_t operator()(const K &key) const
+    {
+      return htable_hash_bin(&key, sizeof(K));
+    }
+  };
+
+  /**
+   * @brief Strings are hashed by their characters, exactly like htable does
+   */
+  template <>
+  struct hmap_hash<const char *>
+  {
+    uint64_t operator()(const char *key) const
+    {
+      return htable_hash_raw(key);
+    }
+  };
+
+  template <>
+  struct hmap_hash<char *>
+  {
+    uint64_t operator()(const char *key) const
+    {
+      return htable_hash_raw(key);
+    }
+  };
+
+  /**
+   * @brief Integers are hashed by the same finalizer as htable_make_u64 tables
+   */
+  #define HMAP_INT_HASH(type)                               \
+    template <>                                             \
+    struct hmap_hash<type>                                  \
+    {                                                       \
+      uint64_t operator()(type key) const                   \
+      {                                                     \
+        return htable_hash_u64((uint64_t) key);             \
+      }                                                     \
+    };
+
+  HMAP_INT_HASH(int8_t)
+  HMAP_INT_HASH(uint8_t)
+  HMAP_INT_HASH(int16_t)
+  HMAP_INT_HASH(uint16_t)
+  HMAP_INT_HASH(int32_t)
+  HMAP_INT_HASH(uint32_t)
+  HMAP_INT_HASH(int64_t)
+  HMAP_INT_HASH(uint64_t)
+
+  #undef HMAP_INT_HASH
+
+  /**
+   * @brief Default comparator, uses the key's equality operator
+   */
+  template <typename K>
+  struct hmap_eq
+  {
+    bool operator()(const K &a, const K &b) const
+    {
+      return a == b;
+    }
+  };
+
+  /**
+   * @brief Strings are compared by their characters, not by their address
+   */
+  template <>
+  struct hmap_eq<const char *>
+  {
+    bool operator()(const char *a, const char *b) const
+    {
+      return strcmp(a, b) == 0;
+    }
+  };
+
+  template <>
+  struct hmap_eq<char *>
+  {
+    bool operator()(const char *a, const char *b) const
+    {
+      return strcmp(a, b) == 0;
+    }
+  };
+
+  /**
+   * @brief Typed hash map with inline keys and values
+   *
+   * INFO: String keys are stored as pointers, they're neither cloned nor
+   * INFO: freed and thus have to outlive the map.
+   *
+   * @tparam K Key type
+   * @tparam V Value type
+   * @tparam Hash Hasher, has to produce a full 64-bit hash
+   * @tparam Eq Key comparator
+   */
+  template <typename K, typename V, typename Hash = hmap_hash<K>, typename Eq = hmap_eq<K>>
+  class hmap
+  {
+  public:
+    /**
+     * @brief Represents an individual k-v pair, stored inline within the slots
+     */
+    struct entry
+    {
+      K key;
+      V value;
+    };
+
+    /**
+     * @brief Allocate a new, empty map
+     *
+     * @param item_cap Maximum number of items stored
+     */
+    explicit hmap(size_t item_cap) : _item_count(0), _item_cap(item_cap)
+    {
+      // Keep the load below HMAP_LOAD_PER_8 / 8, round up to a power of two for masking
+      size_t min_slots = item_cap * 8 / HMAP_LOAD_PER_8 + 1;
+      _slot_count = 8;
+      while (_slot_count < min_slots)
+        _slot_count <<= 1;
+
+      _slots = (entry *) mman_alloc(sizeof(entry), _slot_count, NULL);
+      _meta = (uint8_t *) mman_calloc(sizeof(uint8_t), _slot_count, NULL);
+    }
+
+    ~hmap()
+    {
+      clear();
+      mman_dealloc(_slots);
+      mman_dealloc(_meta);
+    }
+
+    hmap(const hmap &) = delete;
+    hmap &operator=(const hmap &) = delete;
+
+    /**
+     * @brief Insert a new item into the map
+     *
+     * @param key Key to connect with the value
+     * @param value Value, copied into the map
+     *
+     * @return htable_result_t Result of this operation
+     */
+    htable_result_t insert(const K &key, const V &value)
+    {
+      uint64_t hash = _hash(key);
+      size_t index;
+
+      if (probe(key, hash, &index)) return HTABLE_KEY_ALREADY_EXISTS;
+      if (_item_count >= _item_cap) return HTABLE_FULL;
+
+      new (&_slots[index]) entry { key, value };
+      _meta[index] = tag(hash);
+      _item_count++;
+      return HTABLE_SUCCESS;
+    }
+
+    /**
+     * @brief Get an existing key's connected value
+     *
+     * @param key Key connected to the target value
+     * @param output Output pointer buffer, points into the map
+     *
+     * @return htable_result_t Result of this operation
+     */
+    htable_result_t fetch(const K &key, V **output)
+    {
+      V *value = find(key);
+      if (output) *output = value;
+      return value ? HTABLE_SUCCESS : HTABLE_KEY_NOT_FOUND;
+    }
+
+    /**
+     * @brief Get a pointer to an existing key's connected value
+     *
+     * @param key Key connected to the target value
+     * @return V* Value within the map, NULL if the key doesn't exist
+     */
+    V *find(const K &key)
+    {
+      size_t index;
+      if (!probe(key, _hash(key), &index)) return NULL;
+      return &_slots[index].value;
+    }
+
+    /**
+     * @brief Check if the map already contains this key
+     *
+     * @param key Key to check
+     *
+     * @return true Key exists
+     * @return false Key does not exist
+     */
+    bool contains(const K &key)
+    {
+      size_t index;
+      return probe(key, _hash(key), &index);
+    }
+
+    /**
+     * @brief Remove an element by it's key
+     *
+     * @param key Key connected to the target value
+     *
+     * @return htable_result_t Result of this operation
+     */
+    htable_result_t remove(const K &key)
+    {
+      size_t index;
+      if (!probe(key, _hash(key), &index)) return HTABLE_KEY_NOT_FOUND;
+
+      _slots[index].~entry();
+      _meta[index] = HMAP_EMPTY;
+      _item_count--;
+
+      // Shift following entries of the same run back, so that no tombstones are needed
+      size_t mask = _slot_count - 1;
+      for (size_t next = (index + 1) & mask; _meta[next] != HMAP_EMPTY; next = (next + 1) & mask)
+      {
+        // Entries may only move towards their home, never past it
+        size_t home = _hash(_slots[next].key) & mask;
+        if (((next - home) & mask) < ((next - index) & mask))
+          continue;
+
+        new (&_slots[index]) entry { std::move(_slots[next].key), std::move(_slots[next].value) };
+        _slots[next].~entry();
+        _meta[index] = _meta[next];
+        _meta[next] = HMAP_EMPTY;
+        index = next;
+      }
+
+      return HTABLE_SUCCESS;
+    }
+
+    /**
+     * @brief Remove all items from the map
+     */
+    void clear()
+    {
+      for (size_t i = 0; i < _slot_count; i++)
+      {
+        if (_meta[i] == HMAP_EMPTY) continue;
+        _slots[i].~entry();
+        _meta[i] = HMAP_EMPTY;
+      }
+
+      _item_count = 0;
+    }
+
+    /**
+     * @brief Visit all entries of the map in slot order
+     *
+     * @param fn Callable receiving (const K &, V &)
+     */
+    template <typename F>
+    void for_each(F fn)
+    {
+      for (size_t i = 0; i < _slot_count; i++)
+      {
+        if (_meta[i] == HMAP_EMPTY) continue;
+        fn((const K &) _slots[i].key, _slots[i].value);
+      }
+    }
+
+    /**
+     * @brief Get the current number of items in the map
+     */
+    size_t size() const
+    {
+      return _item_count;
+    }
+
+    /**
+     * @brief Get the maximum number of items the map can hold
+     */
+    size_t capacity() const
+    {
+      return _item_cap;
+    }
+
+  private:
+    // Inline entries, only valid where _meta is occupied
+    entry *_slots;
+
+    // One byte per slot, empty or occupied plus seven bits of the hash
+    uint8_t *_meta;
+
+    // Allocated number of slots, always a power of two
+    size_t _slot_count;
+
+    // Current number of items in the map
+    size_t _item_count;
+
+    // Maximum number of items in the map
+    size_t _item_cap;
+
+    Hash _hash;
+    Eq _eq;
+
+    /**
+     * @brief Build the metadata byte of an occupied slot
+     */
+    static uint8_t tag(uint64_t hash)
+    {
+      return HMAP_OCCUPIED | (uint8_t) (hash >> 57);
+    }
+
+    /**
+     * @brief Probe for a key, starting at it's home slot
+     *
+     * @param key Key to search for
+     * @param hash Full hash of the key
+     * @param index Index of the key if found, otherwise the empty slot it would be inserted at
+     *
+     * @return true Key has been found
+     * @return false Key doesn't exist
+     */
+    bool probe(const K &key, uint64_t hash, size_t *index)
+    {
+      size_t mask = _slot_count - 1;
+      uint8_t key_tag = tag(hash);
+
+      // The load is capped, so there's always an empty slot to stop at
+      for (size_t i = hash & mask;; i = (i + 1) & mask)
+      {
+        if (_meta[i] == HMAP_EMPTY)
+        {
+          *index = i;
+          return false;
+        }
+
+        // Compare tags before comparing keys
+        if (_meta[i] == key_tag && _eq(_slots[i].key, key))
+        {
+          *index = i;
+          return true;
+        }
+      }
+    }
+  };
+}
+
+#endif
@@ -21,9 +21,22 @@
 #define HTABLE_MAX_KEYLEN 256
 #define HTABLE_DUMP_LINEBUF 8
 #define HTABLE_ITEMS_PER_SLOT 6
+#define HTABLE_BATCH_SIZE 16
+#define HTABLE_STATS_HIST_LEN 8
+
+// Item cap of tables made by htable_make_unbounded
+#define HTABLE_UNBOUNDED SIZE_MAX
+
+// Highest shrink threshold, shrinking leaves half the designed load so that the next resize is far off either way
+#define HTABLE_MAX_SHRINK_THRESHOLD 0.25
 
 typedef void *(*htable_value_clone_f)(void *);
 
+/**
+ * @brief Serialize a value into a managed buffer, writing the buffer's size into size
+ */
+typedef void *(*htable_value_serializer_f)(void *value, size_t *size);
+
 /**
  * @brief Used when a table is appended into another table
  */
@@ -43,7 +56,11 @@ typedef enum htable_append_mode
   FUN(HTABLE_KEY_ALREADY_EXISTS, 0x2) /* The requested key already exists */          \
   FUN(HTABLE_KEY_TOO_LONG,       0x3) /* The requested key has too many characters */ \
   FUN(HTABLE_FULL,               0x4) /* The table has reached it's defined limit */  \
-  FUN(HTABLE_NULL_VALUE,         0x5) /* Tried to insert a null value */
+  FUN(HTABLE_NULL_VALUE,         0x5) /* Tried to insert a null value */             \
+  FUN(HTABLE_FROZEN,             0x6) /* The table has been frozen and is read-only */ \
+  FUN(HTABLE_NO_PERFECT_HASH,    0x7) /* No minimal perfect hash could be found */   \
+  FUN(HTABLE_KEY_TYPE_MISMATCH,  0x8) /* The key's type doesn't match the table */    \
+  FUN(HTABLE_IO_ERROR,           0x9) /* A snapshot file couldn't be written */
 
 ENUM_TYPEDEF_FULL_IMPL(htable_result, _EVALS_HTABLE_RESULT);
 
@@ -52,13 +69,52 @@ ENUM_TYPEDEF_FULL_IMPL(htable_result, _EVALS_HTABLE_RESULT);
  */
 typedef struct htable_entry
 {
-  char *key;
+  union
+  {
+    // Byte key, NULL-terminated, stored right behind the entry
+    char *key;
+
+    // Integer key, used by tables made through htable_make_u64
+    uint64_t int_key;
+  };
+
+  // Length of the byte key, excluding the terminator
+  size_t key_len;
+
+  // Full hash of the key, compared before the key itself
+  uint64_t _hash;
+
   void *value;
 
   // Next link for the linked-list on this slot
   struct htable_entry *_next;
 } htable_entry_t;
 
+/**
+ * @brief Represents the immutable, minimal perfect hash indexed
+ * state of a table after it has been frozen
+ */
+typedef struct htable_frozen
+{
+  // Contiguous entries, one per key, no empty slots and no chains
+  htable_entry_t *entries;
+
+  // Number of entries
+  size_t _entry_count;
+
+  // Displacement per bucket, (d0 << 32) | d1
+  uint64_t *displacements;
+
+  // Number of displacement buckets
+  size_t _bucket_count;
+
+  // Seed the displacements have been computed with
+  uint64_t _seed;
+
+  // All byte keys, NULL-terminated, back to back
+  char *keys;
+} htable_frozen_t;
+
 /**
  * @brief Represents a table having it's entries and a fixed size
  */
@@ -78,8 +134,188 @@ typedef struct
 
   // Cleanup function for the table items
   clfn_t _cf;
+
+  // Whether the table is keyed by integers instead of strings or byte spans
+  bool _int_keys;
+
+  // Fraction of the designed load below which removals shrink the slots, 0 disables shrinking
+  double _shrink_threshold;
+
+  // Frozen state, NULL as long as the table is still mutable
+  htable_frozen_t *_frozen;
+
+  // Filter answering most misses without touching the slots, NULL if not attached
+  struct bloom *_bloom;
+
+  // Whether lookups are counted at runtime, off by default
+  bool _probe_stats;
+
+  // Number of lookups and entries compared during them
+  volatile size_t _lookups;
+  volatile size_t _probes;
 } htable_t;
 
+/**
+ * @brief Occupancy and probe-length figures of a table
+ */
+typedef struct htable_stats
+{
+  size_t item_count;              // Number of items
+  size_t slot_count;              // Number of slots, entries for frozen tables
+  size_t empty_slots;             // Number of slots without any entry
+  double load_factor;             // Items per slot
+
+  // Number of slots per chain length, the last bucket collects all longer chains
+  size_t chain_hist[HTABLE_STATS_HIST_LEN];
+
+  size_t max_chain;               // Length of the longest chain
+  double avg_probes;              // Average entries compared per successful lookup
+
+  size_t lookups;                 // Number of lookups counted at runtime
+  size_t probes;                  // Number of entries compared during them
+} htable_stats_t;
+
+/*
+============================================================================
+                                  Hashing                                   
+============================================================================
+*/
+
+/**
+ * @brief Calculate the full 64-bit FNV-1a hash of a string key
+ * 
+ * @param key String key to calculate on
+ * @return uint64_t Hash value, not yet constrained to any range
+ */
+INLINED static uint64_t htable_hash_raw(const char *key)
+{
+  // Start out at the specified offset
+  uint64_t hash = HTABLE_FNV_OFFSET;
+
+  // Apply bitops for each char in the string
+  for (const char *c = key; *c; c++)
+  {
+    hash ^= (uint64_t)(*c);
+    hash *= HTABLE_FNV_PRIME;
+  }
+
+  return hash;
+}
+
+/**
+ * @brief Calculate the full 64-bit FNV-1a hash of a byte span, which
+ * equals htable_hash_raw for the characters of a string
+ * 
+ * @param key Bytes to calculate on
+ * @param len Number of bytes
+ * @return uint64_t Hash value, not yet constrained to any range
+ */
+INLINED static uint64_t htable_hash_bin(const void *key, size_t len)
+{
+  // Start out at the specified offset
+  uint64_t hash = HTABLE_FNV_OFFSET;
+
+  // Apply bitops for each byte in the span
+  const char *bytes = (const char *) key;
+  for (size_t i = 0; i < len; i++)
+  {
+    hash ^= (uint64_t)(bytes[i]);
+    hash *= HTABLE_FNV_PRIME;
+  }
+
+  return hash;
+}
+
+/**
+ * @brief Calculate the full 64-bit hash of an integer key by
+ * applying the splitmix64 finalizer
+ * 
+ * @param key Integer key to calculate on
+ * @return uint64_t Hash value, not yet constrained to any range
+ */
+INLINED static uint64_t htable_hash_u64(uint64_t key)
+{
+  key ^= key >> 30;
+  key *= 0xBF58476D1CE4E5B9UL;
+  key ^= key >> 27;
+  key *= 0x94D049BB133111EBUL;
+  key ^= key >> 31;
+  return key;
+}
+
+/*
+============================================================================
+                                    Keys                                    
+============================================================================
+*/
+
+/**
+ * @brief Represents a key of any supported type together with it's hash
+ */
+typedef struct htable_key
+{
+  const char *bytes;    // Byte key, unused for integer keys
+  size_t len;           // Number of bytes
+  uint64_t int_key;     // Integer key, unused for byte keys
+  bool is_int;          // Whether this is an integer key
+  uint64_t hash;        // Full hash of the key
+} htable_key_t;
+
+/**
+ * @brief Create a key from a string
+ */
+INLINED static htable_key_t htable_key_str(const char *key)
+{
+  size_t len = strlen(key);
+  return (htable_key_t) { key, len, 0, false, htable_hash_bin(key, len) };
+}
+
+/**
+ * @brief Create a key from a byte span
+ */
+INLINED static htable_key_t htable_key_bin(const void *key, size_t len)
+{
+  return (htable_key_t) { (const char *) key, len, 0, false, htable_hash_bin(key, len) };
+}
+
+/**
+ * @brief Create a key from an integer
+ */
+INLINED static htable_key_t htable_key_u64(uint64_t key)
+{
+  return (htable_key_t) { NULL, 0, key, true, htable_hash_u64(key) };
+}
+
+/**
+ * @brief Check whether an entry holds the given key
+ * 
+ * @param entry Entry to check
+ * @param key Key to check for, has to match the table's key type
+ * 
+ * @return true Entry holds this key
+ * @return false Entry holds another key
+ */
+INLINED static bool htable_entry_matches(htable_entry_t *entry, htable_key_t *key)
+{
+  // Differing hashes rule out most mismatches without touching the key
+  if (entry->_hash != key->hash) return false;
+  if (key->is_int) return entry->int_key == key->int_key;
+  return entry->key_len == key->len && memcmp(entry->key, key->bytes, key->len) == 0;
+}
+
+/**
+ * @brief Get the key an entry holds, reusing it's stored hash
+ * 
+ * @param entry Entry to get the key of
+ * @param is_int Whether the entry's table is keyed by integers
+ * @return htable_key_t Key of the entry
+ */
+INLINED static htable_key_t htable_entry_key(htable_entry_t *entry, bool is_int)
+{
+  if (is_int) return (htable_key_t) { NULL, 0, entry->int_key, true, entry->_hash };
+  return (htable_key_t) { entry->key, entry->key_len, 0, false, entry->_hash };
+}
+
 /**
  * @brief Allocate a new, empty table
  * 
@@ -89,6 +325,25 @@ typedef struct
  */
 htable_t *htable_make(size_t item_cap, clfn_t cf);
 
+/**
+ * @brief Allocate a new, empty table which is keyed by integers
+ * 
+ * @param item_cap Maximum number of items stored
+ * @param cf Cleanup function for the items
+ * @return htable_t* Pointer to the new table
+ */
+htable_t *htable_make_u64(size_t item_cap, clfn_t cf);
+
+/**
+ * @brief Allocate a new, empty table without an item cap, which starts out
+ * sized for the given number of items and keeps growing it's slots on demand
+ * 
+ * @param initial_items Number of items the initial slots are sized for
+ * @param cf Cleanup function for the items
+ * @return htable_t* Pointer to the new table
+ */
+htable_t *htable_make_unbounded(size_t initial_items, clfn_t cf);
+
 /**
  * @brief Insert a new item into the table
  * 
@@ -143,6 +398,22 @@ htable_result_t htable_fetch(htable_t *table, const char *key, void **output);
  */
 htable_result_t htable_append_table(htable_t *dest, htable_t *src, htable_append_mode_t mode, htable_value_clone_f cf);
 
+/**
+ * @brief Append all keys of a table to another table, partitioned by the destination
+ * slots into parts run on a thread pool, where each part owns a disjoint set of slots
+ * and thus needs no locks. The destination is grown to it's designed slot count beforehand.
+ * 
+ * INFO: The clone function is called from multiple threads at once
+ * 
+ * @param dest Destination to append to
+ * @param src Source to append from, not to be modified while appending
+ * @param mode Mode of appending
+ * @param cf Clone function used to copy over values
+ * @param pool Pool to run the parts on
+ * @return htable_result_t Operation result
+ */
+htable_result_t htable_append_table_parallel(htable_t *dest, htable_t *src, htable_append_mode_t mode, htable_value_clone_f cf, struct tpool *pool);
+
 /**
  * @brief Get a list of all existing keys inside the table
  * 
@@ -153,6 +424,16 @@ htable_result_t htable_append_table(htable_t *dest, htable_t *src, htable_append
  */
 size_t htable_list_keys(htable_t *table, char ***output);
 
+/**
+ * @brief Get a list of all existing entries inside the table, frozen or not
+ * 
+ * @param table Table reference
+ * @param output Entry array pointer buffer, NULL-terminated
+ * 
+ * @returns Number of entries returned
+ */
+size_t htable_list_entries(htable_t *table, htable_entry_t ***output);
+
 /**
  * @brief Dumps the current state of the table in a human readable format
  * 
@@ -162,4 +443,443 @@ size_t htable_list_keys(htable_t *table, char ***output);
  */
 char *htable_dump_hr(htable_t *table, stringifier_t stringifier);
 
+/*
+============================================================================
+                              Generic Keys                                  
+============================================================================
+*/
+
+/**
+ * @brief Insert a new item into the table by a prepared key of any type, which
+ * allows to hash a key once and reuse it over multiple operations
+ * 
+ * @param table Table reference
+ * @param key Key to connect with the value, see htable_key_str, htable_key_bin and htable_key_u64
+ * @param elem Pointer to the value
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_insert_key(htable_t *table, htable_key_t *key, void *elem);
+
+/**
+ * @brief Insert a new item by a prepared key, just like htable_insert_key, and
+ * hand out the new entry, sparing a lookup to get at the table's copy of the key
+ * 
+ * @param table Table reference
+ * @param key Key to connect with the value
+ * @param elem Pointer to the value
+ * @param entry New entry output, set to NULL if not needed
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_insert_entry(htable_t *table, htable_key_t *key, void *elem, htable_entry_t **entry);
+
+/**
+ * @brief Remove an element by a prepared key of any type
+ * 
+ * @param table Table reference
+ * @param key Key connected to the target value
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_remove_key(htable_t *table, htable_key_t *key);
+
+/**
+ * @brief Get the value connected to a prepared key of any type
+ * 
+ * @param table Table reference
+ * @param key Key connected to the target value
+ * @param output Output pointer buffer
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_fetch_key(htable_t *table, htable_key_t *key, void **output);
+
+/**
+ * @brief Get the entry holding a prepared key of any type
+ * 
+ * @param table Table reference
+ * @param key Key to search for
+ * 
+ * @return htable_entry_t* Matching entry, NULL if the key doesn't exist
+ */
+htable_entry_t *htable_find_entry(htable_t *table, htable_key_t *key);
+
+/*
+============================================================================
+                          Integer and Binary Keys                           
+============================================================================
+*/
+
+/**
+ * @brief Insert a new item into a table made by htable_make_u64
+ * 
+ * @param table Table reference
+ * @param key Key to connect with the value
+ * @param elem Pointer to the value
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_insert_u64(htable_t *table, uint64_t key, void *elem);
+
+/**
+ * @brief Check if a table made by htable_make_u64 already contains this key
+ * 
+ * @param table Table reference
+ * @param key Key to check
+ * 
+ * @return true Key exists
+ * @return false Key does not exist
+ */
+bool htable_contains_u64(htable_t *table, uint64_t key);
+
+/**
+ * @brief Remove an element by it's key from a table made by htable_make_u64
+ * 
+ * @param table Table reference
+ * @param key Key connected to the target value
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_remove_u64(htable_t *table, uint64_t key);
+
+/**
+ * @brief Get an existing key's connected value from a table made by htable_make_u64
+ * 
+ * @param table Table reference
+ * @param key Key connected to the target value
+ * @param output Output pointer buffer
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_fetch_u64(htable_t *table, uint64_t key, void **output);
+
+/**
+ * @brief Get a list of all existing keys inside a table made by htable_make_u64
+ * 
+ * @param table Table reference
+ * @param output Integer array pointer buffer
+ * 
+ * @returns Number of keys returned
+ */
+size_t htable_list_keys_u64(htable_t *table, uint64_t **output);
+
+/**
+ * @brief Insert a new item into the table, keyed by an arbitrary byte span. A
+ * string key equals the span of it's characters, without the terminator.
+ * 
+ * @param table Table reference
+ * @param key Start of the key
+ * @param key_len Number of bytes the key consists of
+ * @param elem Pointer to the value
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_insert_bin(htable_t *table, const void *key, size_t key_len, void *elem);
+
+/**
+ * @brief Check if the table already contains this byte span key
+ * 
+ * @param table Table reference
+ * @param key Start of the key
+ * @param key_len Number of bytes the key consists of
+ * 
+ * @return true Key exists
+ * @return false Key does not exist
+ */
+bool htable_contains_bin(htable_t *table, const void *key, size_t key_len);
+
+/**
+ * @brief Remove an element by it's byte span key
+ * 
+ * @param table Table reference
+ * @param key Start of the key
+ * @param key_len Number of bytes the key consists of
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_remove_bin(htable_t *table, const void *key, size_t key_len);
+
+/**
+ * @brief Get an existing byte span key's connected value
+ * 
+ * @param table Table reference
+ * @param key Start of the key
+ * @param key_len Number of bytes the key consists of
+ * @param output Output pointer buffer
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_fetch_bin(htable_t *table, const void *key, size_t key_len, void **output);
+
+/*
+============================================================================
+                                  Resizing                                  
+============================================================================
+*/
+
+/**
+ * @brief Rehash all entries into a new slot array, reusing their stored hashes
+ * 
+ * @param table Table reference
+ * @param slot_count New number of slots, at least one
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_rehash(htable_t *table, size_t slot_count);
+
+/**
+ * @brief Rehash into a slot array holding the items at half of HTABLE_ITEMS_PER_SLOT
+ * items per slot and thus give the unused slot memory back, while leaving headroom
+ * for further insertions. Tables grow their slots again on demand, up to the number
+ * of slots their item cap has been sized for.
+ * 
+ * @param table Table reference
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_shrink_to_fit(htable_t *table);
+
+/**
+ * @brief Automatically shrink a table to fit whenever a removal leaves it
+ * below the given fraction of it's designed load
+ * 
+ * @param table Table reference
+ * @param threshold Fraction of HTABLE_ITEMS_PER_SLOT items per slot, 0 disables shrinking,
+ * clamped to HTABLE_MAX_SHRINK_THRESHOLD
+ */
+void htable_set_shrink_threshold(htable_t *table, double threshold);
+
+/*
+============================================================================
+                                Bloom Filter                                
+============================================================================
+*/
+
+/**
+ * @brief Attach a bloom filter sized for the table's item cap, or the designed load
+ * of it's current slots if it's unbounded, which is filled
+ * with all current keys and kept up to date on insertion, so that lookups of
+ * missing keys mostly return before touching any slot
+ * 
+ * INFO: Removed keys stay within the filter, reattach after mass removals
+ * 
+ * @param table Table reference
+ * @param bits_per_item Number of filter bits per item, replaces an already attached filter
+ */
+void htable_attach_bloom(htable_t *table, size_t bits_per_item);
+
+/**
+ * @brief Detach and free the table's bloom filter, if any
+ * 
+ * @param table Table reference
+ */
+void htable_detach_bloom(htable_t *table);
+
+/*
+============================================================================
+                               Introspection                                
+============================================================================
+*/
+
+/**
+ * @brief Collect occupancy and probe-length statistics of a table by a
+ * single pass over it's slots. Runtime lookup counts are only collected
+ * while enabled by htable_set_probe_stats.
+ * 
+ * @param table Table reference
+ * @param output Statistics output buffer
+ */
+void htable_stats(htable_t *table, htable_stats_t *output);
+
+/**
+ * @brief Enable or disable counting lookups and compared entries at runtime,
+ * which costs atomic increments on every lookup
+ * 
+ * @param table Table reference
+ * @param enabled Whether to count
+ */
+void htable_set_probe_stats(htable_t *table, bool enabled);
+
+/*
+============================================================================
+                              Batched Lookups                               
+============================================================================
+*/
+
+/**
+ * @brief Get the connected values of multiple keys at once. All keys of a batch
+ * are hashed first, their slots and entries get prefetched and only then are
+ * the results resolved, so that the cache misses of all keys overlap.
+ * 
+ * @param table Table reference
+ * @param keys Keys to look up
+ * @param n Number of keys
+ * @param out Output buffer with room for n values, missing keys result in NULL
+ * 
+ * @return size_t Number of keys that have been found
+ */
+size_t htable_fetch_many(htable_t *table, const char **keys, size_t n, void **out);
+
+/**
+ * @brief Check whether or not the table contains multiple keys at once, see htable_fetch_many
+ * 
+ * @param table Table reference
+ * @param keys Keys to check
+ * @param n Number of keys
+ * @param out Output buffer with room for n states
+ * 
+ * @return size_t Number of keys that exist
+ */
+size_t htable_contains_many(htable_t *table, const char **keys, size_t n, bool *out);
+
+/*
+============================================================================
+                                 Snapshots                                  
+============================================================================
+*/
+
+#define HTABLE_SNAPSHOT_MAGIC "BLVKHTBL"
+#define HTABLE_SNAPSHOT_VERSION 1
+
+// Snapshot flags
+#define HTABLE_SNAPSHOT_INT_KEYS 0x1
+
+/**
+ * @brief Leading block of a snapshot file, followed by the slot offsets
+ */
+typedef struct htable_snapshot_header
+{
+  char magic[8];          // HTABLE_SNAPSHOT_MAGIC, not terminated
+  uint32_t version;       // HTABLE_SNAPSHOT_VERSION
+  uint32_t flags;         // HTABLE_SNAPSHOT_* flags
+  uint64_t item_count;    // Number of entries
+  uint64_t slot_count;    // Number of slot offsets following this header
+} htable_snapshot_header_t;
+
+/**
+ * @brief Entry record within a snapshot file, followed by the key
+ * bytes (NULL-terminated) and the value bytes, each aligned to eight bytes
+ */
+typedef struct htable_snapshot_entry
+{
+  uint64_t hash;          // Full hash of the key
+  uint64_t next;          // File offset of the next entry in this chain, 0 ends the chain
+  uint64_t key;           // Integer key or the byte key's length
+  uint64_t value_size;    // Number of value bytes
+} htable_snapshot_entry_t;
+
+/**
+ * @brief Represents a read-only snapshot which has been mapped into memory
+ */
+typedef struct htable_mapped
+{
+  // Start of the mapping, which is the file's header
+  const htable_snapshot_header_t *header;
+
+  // File offsets of each slot's first entry, 0 for empty slots
+  const uint64_t *slots;
+
+  // Number of mapped bytes
+  size_t _size;
+} htable_mapped_t;
+
+/**
+ * @brief Write a table into a snapshot file which can be mapped by htable_map.
+ * The file is written next to the target and renamed once complete.
+ * 
+ * @param table Table to save
+ * @param path Path of the snapshot file
+ * @param value_serializer Serializer for values, leave as NULL to store values as strings
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_save(htable_t *table, const char *path, htable_value_serializer_f value_serializer);
+
+/**
+ * @brief Map a snapshot file read-only into memory, without rebuilding any entries. All
+ * lookups are resolved through offsets within the mapping, whose pages are shared
+ * between all processes mapping the same file.
+ * 
+ * @param path Path of the snapshot file
+ * 
+ * @return htable_mapped_t* Mapped snapshot, NULL if the file couldn't be mapped or is invalid
+ */
+htable_mapped_t *htable_map(const char *path);
+
+/**
+ * @brief Get a string key's serialized value from a mapped snapshot
+ * 
+ * @param mapped Mapped snapshot
+ * @param key Key connected to the target value
+ * @param value Output pointer buffer, pointing into the mapping
+ * @param size Value size output, leave as NULL if not needed
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_mapped_fetch(htable_mapped_t *mapped, const char *key, const void **value, size_t *size);
+
+/**
+ * @brief Get a prepared key's serialized value from a mapped snapshot
+ * 
+ * @param mapped Mapped snapshot
+ * @param key Key connected to the target value, see htable_key_str, htable_key_bin and htable_key_u64
+ * @param value Output pointer buffer, pointing into the mapping
+ * @param size Value size output, leave as NULL if not needed
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_mapped_fetch_key(htable_mapped_t *mapped, htable_key_t *key, const void **value, size_t *size);
+
+/*
+============================================================================
+                                  Freezing                                  
+============================================================================
+*/
+
+/**
+ * @brief Convert a table into an immutable structure, where all entries are
+ * stored contiguously and indexed by a minimal perfect hash. Every lookup takes
+ * exactly one probe afterwards. htable_fetch, htable_contains, htable_list_keys
+ * and htable_dump_hr keep working as before, while all mutating calls
+ * will result in HTABLE_FROZEN. Tables holding keys with equal hashes, such as
+ * duplicate keys, fail with HTABLE_NO_PERFECT_HASH right away.
+ * 
+ * @param table Table to freeze
+ * 
+ * @return htable_result_t Result of this operation
+ */
+htable_result_t htable_freeze(htable_t *table);
+
+/**
+ * @brief Check whether or not a table has been frozen
+ * 
+ * @param table Table reference
+ * 
+ * @return true Table is frozen
+ * @return false Table is still mutable
+ */
+bool htable_is_frozen(htable_t *table);
+
+/**
+ * @brief Get the only entry a key with the given hash could be stored at
+ * within the frozen state of a table, without comparing keys
+ * 
+ * @param frozen Frozen state of a table
+ * @param hash Full hash of the key
+ * 
+ * @return htable_entry_t* Candidate entry, NULL if the table is empty
+ */
+htable_entry_t *htable_frozen_probe(htable_frozen_t *frozen, uint64_t hash);
+
+/**
+ * @brief Look up a key within the frozen state of a table
+ * 
+ * @param frozen Frozen state of a table
+ * @param key Key to look up
+ * 
+ * @return htable_entry_t* Matching entry, NULL if the key doesn't exist
+ */
+htable_entry_t *htable_frozen_find(htable_frozen_t *frozen, htable_key_t *key);
+
 #endif
\ No newline at end of file
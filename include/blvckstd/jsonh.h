@@ -37,6 +37,7 @@
   FUN(JOPRES_INVALID_KEY,     0x4) /* The requested key does not exist */
 
 #define JSONH_ROOT_ITEM_CAP 1024
+#define JSONH_ARR_ITEM_CAP (1024 * 1024)
 
 ENUM_TYPEDEF_FULL_IMPL(jsonh_datatype, _EVALS_JSONH_DTYPE);
 ENUM_TYPEDEF_FULL_IMPL(jsonh_literal, _EVALS_JSONH_LITERAL);
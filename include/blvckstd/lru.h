@@ -0,0 +1,142 @@
+#ifndef lru_h
+#define lru_h
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "blvckstd/htable.h"
+#include "blvckstd/mman.h"
+#include "blvckstd/enumlut.h"
+#include "blvckstd/common_types.h"
+
+// Number of entries the lookup table is sized for initially if there's no entry limit
+#define LRU_UNBOUNDED_INITIAL_ENTRIES 64
+
+/**
+ * @brief Represents lru operation results
+ */
+#define _EVALS_LRU_RESULT(FUN)                                                        \
+  FUN(LRU_SUCCESS,            0x0) /* Operation has been successful */                \
+  FUN(LRU_KEY_NOT_FOUND,      0x1) /* The requested key couldn't be located */        \
+  FUN(LRU_EXPIRED,            0x2) /* The requested key's TTL ran out, it's evicted */ \
+  FUN(LRU_KEY_TOO_LONG,       0x3) /* The requested key has too many characters */    \
+  FUN(LRU_TOO_LARGE,          0x4) /* The value alone exceeds the byte capacity */    \
+  FUN(LRU_NULL_VALUE,         0x5) /* Tried to insert a null value */               \
+  FUN(LRU_FULL,               0x6) /* The lookup table couldn't take another entry */
+
+ENUM_TYPEDEF_FULL_IMPL(lru_result, _EVALS_LRU_RESULT);
+
+/**
+ * @brief Represents an individual cached value, which is linked
+ * into the recency list and stored as the value of the lookup table
+ */
+typedef struct lru_node
+{
+  // Key of the node, pointing into the lookup table's entry
+  htable_key_t key;
+
+  void *value;
+
+  // Number of bytes this value accounts for
+  size_t size;
+
+  // Monotonic expiry time in milliseconds, 0 means never
+  uint64_t expires_at;
+
+  // Links of the recency list, _prev points towards more recent nodes
+  struct lru_node *_prev;
+  struct lru_node *_next;
+} lru_node_t;
+
+/**
+ * @brief Represents a cache, evicting it's least recently used values
+ * once either of the capacity limits has been reached
+ */
+typedef struct
+{
+  // Lookup table, key to node
+  htable_t *table;
+
+  // Most and least recently used nodes
+  lru_node_t *_head;
+  lru_node_t *_tail;
+
+  // Current and maximum number of entries, a maximum of 0 means no limit
+  size_t _count;
+  size_t _max_entries;
+
+  // Current and maximum number of bytes, a maximum of 0 means no limit
+  size_t _bytes;
+  size_t _max_bytes;
+
+  // Cleanup function for values leaving the cache
+  clfn_t _cf;
+
+  // Callback invoked with values that get evicted, before they're cleaned up
+  clfn_t _evict_cb;
+} lru_t;
+
+/**
+ * @brief Allocate a new, empty cache
+ *
+ * @param max_entries Maximum number of entries, also used to size the lookup table, 0 for no limit
+ * @param max_bytes Maximum number of bytes over all entry sizes, 0 for no limit
+ * @param cf Cleanup function for the values
+ * @param evict_cb Callback for evicted values, invoked before cf, leave as NULL if not needed
+ * @return lru_t* Pointer to the new cache
+ */
+lru_t *lru_make(size_t max_entries, size_t max_bytes, clfn_t cf, clfn_t evict_cb);
+
+/**
+ * @brief Insert or replace a value and mark it as the most recently used one,
+ * evicting the least recently used values until both limits are satisfied
+ *
+ * @param lru Cache reference
+ * @param key Key to connect with the value
+ * @param value Pointer to the value
+ * @param size Number of bytes the value accounts for
+ * @param ttl_ms Time to live in milliseconds, 0 for no expiry
+ *
+ * @return lru_result_t Result of this operation
+ */
+lru_result_t lru_put(lru_t *lru, const char *key, void *value, size_t size, uint64_t ttl_ms);
+
+/**
+ * @brief Get a value and mark it as the most recently used one
+ *
+ * @param lru Cache reference
+ * @param key Key connected to the target value
+ * @param output Output pointer buffer
+ *
+ * @return lru_result_t Result of this operation
+ */
+lru_result_t lru_get(lru_t *lru, const char *key, void **output);
+
+/**
+ * @brief Remove a value, without invoking the eviction callback
+ *
+ * @param lru Cache reference
+ * @param key Key connected to the target value
+ *
+ * @return lru_result_t Result of this operation
+ */
+lru_result_t lru_remove(lru_t *lru, const char *key);
+
+/**
+ * @brief Evict all values whose TTL ran out
+ *
+ * @param lru Cache reference
+ * @return size_t Number of evicted values
+ */
+size_t lru_prune_expired(lru_t *lru);
+
+/**
+ * @brief Get the current number of cached values
+ *
+ * @param lru Cache reference
+ */
+size_t lru_count(lru_t *lru);
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef mpmc_h
+#define mpmc_h
+
+/*
+  Bounded multi-producer/multi-consumer queue.
+
+  Items of a fixed size are copied into a ring of cells, where every cell
+  carries a sequence number telling whether it's ready to be written or read
+  for the current lap. Producers and consumers only ever contend on claiming
+  a position, never on a lock. Queue a pointer's address with an item size
+  of sizeof(void *) to pass pointers.
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sched.h>
+#include <inttypes.h>
+
+#include "blvckstd/mman.h"
+#include "blvckstd/atomanip.h"
+#include "blvckstd/common_types.h"
+
+// Size of a cache line, used to keep both ends of the queue apart
+#define MPMC_CACHE_LINE 64
+
+// Number of failed attempts before blocking calls start yielding
+#define MPMC_SPIN_LIMIT 64
+
+/**
+ * @brief Represents the queue, keeping track of it's
+ * cells, both ends and cleanup method
+ */
+typedef struct
+{
+  // Ring of cells, a sequence number followed by the item each
+  char *cells;
+
+  // Size of a cell in bytes, keeps sequence numbers aligned
+  size_t _cell_size;
+
+  // Size of an individual item in bytes
+  size_t _item_size;
+
+  // Number of cells minus one, the number of cells is a power of two
+  size_t _mask;
+
+  // Cleanup function, invoked with a pointer to each item left over
+  clfn_t _cf;
+
+  // Next position to push to
+  char _pad_head[MPMC_CACHE_LINE];
+  volatile size_t _head;
+
+  // Next position to pop from
+  char _pad_tail[MPMC_CACHE_LINE - sizeof(size_t)];
+  volatile size_t _tail;
+  char _pad_end[MPMC_CACHE_LINE - sizeof(size_t)];
+} mpmc_t;
+
+/**
+ * @brief Make a new, empty queue
+ *
+ * @param capacity Number of items the queue holds, rounded up to a power of two
+ * @param item_size Size of an individual item in bytes
+ * @param cf Cleanup function, invoked with a pointer to each item left over
+ * @return mpmc_t* Pointer to the new queue
+ */
+mpmc_t *mpmc_make(size_t capacity, size_t item_size, clfn_t cf);
+
+/**
+ * @brief Copy an item into the queue, if there's space left
+ *
+ * @param queue Queue reference
+ * @param item Item to copy in
+ * @return true The item has been pushed
+ * @return false The queue is full
+ */
+bool mpmc_try_push(mpmc_t *queue, const void *item);
+
+/**
+ * @brief Copy an item out of the queue, if there is one
+ *
+ * @param queue Queue reference
+ * @param out Buffer of at least the item size
+ * @return true An item has been popped
+ * @return false The queue is empty
+ */
+bool mpmc_try_pop(mpmc_t *queue, void *out);
+
+/**
+ * @brief Copy an item into the queue, waiting for space if it's full
+ *
+ * @param queue Queue reference
+ * @param item Item to copy in
+ */
+void mpmc_push(mpmc_t *queue, const void *item);
+
+/**
+ * @brief Copy an item out of the queue, waiting for one if it's empty
+ *
+ * @param queue Queue reference
+ * @param out Buffer of at least the item size
+ */
+void mpmc_pop(mpmc_t *queue, void *out);
+
+/**
+ * @brief Copy consecutive items into the queue until it's full, claiming
+ * all cells ready at once, so that the whole batch costs a single CAS
+ *
+ * @param queue Queue reference
+ * @param items Items to copy in, laid out back to back
+ * @param count Number of items
+ * @return size_t Number of items pushed
+ */
+size_t mpmc_try_push_n(mpmc_t *queue, const void *items, size_t count);
+
+/**
+ * @brief Copy items out of the queue until it's empty, claiming all
+ * cells ready at once, so that the whole batch costs a single CAS
+ *
+ * @param queue Queue reference
+ * @param out Buffer of at least count times the item size
+ * @param count Maximum number of items
+ * @return size_t Number of items popped
+ */
+size_t mpmc_try_pop_n(mpmc_t *queue, void *out, size_t count);
+
+/**
+ * @brief Get the approximate number of items in the queue, exact only without concurrent access
+ *
+ * @param queue Queue reference
+ */
+size_t mpmc_length(mpmc_t *queue);
+
+#endif
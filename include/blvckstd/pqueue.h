@@ -0,0 +1,157 @@
+#ifndef pqueue_h
+#define pqueue_h
+
+/*
+  Priority queue as a 4-ary heap.
+
+  Every pushed item gets a handle, which keeps track of the item's position
+  within the heap, so that it can be reordered after it's priority changed or
+  removed without searching for it. Handles stay valid until their item leaves
+  the queue and are reused afterwards.
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "blvckstd/mman.h"
+#include "blvckstd/enumlut.h"
+#include "blvckstd/uminmax.h"
+#include "blvckstd/common_types.h"
+
+// Number of children per node
+#define PQUEUE_ARITY 4
+
+/**
+ * @brief Represents pqueue operation results
+ */
+#define _EVALS_PQUEUE_RESULT(FUN)                                                        \
+  FUN(PQUEUE_SUCCESS,        0x0) /* Operation has been successful */                    \
+  FUN(PQUEUE_INVALID_HANDLE, 0x1) /* The handle doesn't refer to an item in the queue */ \
+  FUN(PQUEUE_FULL,           0x2) /* The queue reached it's maximum size */              \
+  FUN(PQUEUE_EMPTY,          0x3) /* There are no items in the queue */
+
+ENUM_TYPEDEF_FULL_IMPL(pqueue_result, _EVALS_PQUEUE_RESULT);
+
+/**
+ * @brief Compares two items, returning <0 if a is to be popped before b, 0 if equal, >0 otherwise
+ */
+typedef int (*pqueue_cmp_f)(const void *a, const void *b);
+
+/**
+ * @brief Represents the priority queue, keeping track of it's
+ * heap, handles and cleanup method
+ */
+typedef struct
+{
+  // Heap of items, the root is popped first
+  void **items;
+
+  // Handle of each heap position
+  size_t *_handles;
+
+  // Heap position of each handle in use, next free handle otherwise
+  size_t *_positions;
+
+  // Number of items and handles taken into use
+  size_t _length;
+  size_t _handle_count;
+
+  // Head of the free handle list, SIZE_MAX if empty
+  size_t _free_head;
+
+  // Current allocated size of the heap and handles
+  size_t _array_size;
+
+  // Maximum number of items the queue can grow to
+  size_t _array_cap;
+
+  pqueue_cmp_f _cmp;
+
+  // Cleanup function for the items
+  clfn_t _cf;
+} pqueue_t;
+
+/**
+ * @brief Make a new, empty priority queue
+ *
+ * @param array_size Initial number of items to allocate
+ * @param array_max_size Maximum number of items, set to array_size for no automatic growth
+ * @param cmp Comparator deciding the order
+ * @param cf Cleanup function for the items
+ * @return pqueue_t* Pointer to the new queue
+ */
+pqueue_t *pqueue_make(size_t array_size, size_t array_max_size, pqueue_cmp_f cmp, clfn_t cf);
+
+/**
+ * @brief Push a new item
+ *
+ * @param pq Queue reference
+ * @param item Item to push
+ * @param handle Handle of the item, set to NULL if not needed
+ * @return pqueue_result_t Operation result
+ */
+pqueue_result_t pqueue_push(pqueue_t *pq, void *item, size_t *handle);
+
+/**
+ * @brief Get the item which would be popped next
+ *
+ * @param pq Queue reference
+ * @return void* Item, NULL if the queue is empty
+ */
+void *pqueue_peek(pqueue_t *pq);
+
+/**
+ * @brief Remove the item which comes first
+ *
+ * @param pq Queue reference
+ * @param out Removed item output, cleaned up if set to NULL
+ * @return pqueue_result_t Operation result
+ */
+pqueue_result_t pqueue_pop(pqueue_t *pq, void **out);
+
+/**
+ * @brief Get the item a handle refers to
+ *
+ * @param pq Queue reference
+ * @param handle Handle of the item
+ * @return void* Item, NULL if the handle is out of range
+ */
+void *pqueue_get(pqueue_t *pq, size_t handle);
+
+/**
+ * @brief Restore the order after the priority of an item has been raised, as in decrease-key
+ *
+ * @param pq Queue reference
+ * @param handle Handle of the item
+ * @return pqueue_result_t Operation result
+ */
+pqueue_result_t pqueue_decrease_key(pqueue_t *pq, size_t handle);
+
+/**
+ * @brief Restore the order after the priority of an item has changed in any direction
+ *
+ * @param pq Queue reference
+ * @param handle Handle of the item
+ * @return pqueue_result_t Operation result
+ */
+pqueue_result_t pqueue_update(pqueue_t *pq, size_t handle);
+
+/**
+ * @brief Remove an item by it's handle
+ *
+ * @param pq Queue reference
+ * @param handle Handle of the item
+ * @param out Removed item output, cleaned up if set to NULL
+ * @return pqueue_result_t Operation result
+ */
+pqueue_result_t pqueue_remove(pqueue_t *pq, size_t handle, void **out);
+
+/**
+ * @brief Get the number of items in the queue
+ *
+ * @param pq Queue reference
+ */
+size_t pqueue_length(pqueue_t *pq);
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef slotmap_h
+#define slotmap_h
+
+/*
+  Generational handles on top of dynarr-style slot indices.
+
+  Every slot carries a generation which is bumped whenever it's item gets
+  removed, so a handle to a removed item never resolves to whatever reuses
+  it's slot later on. Values are kept densely packed in insertion order until
+  a removal moves the last value into the gap, so iterating over values
+  never has to skip holes. Results are reported through dynarr_result_t.
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "blvckstd/mman.h"
+#include "blvckstd/dynarr.h"
+#include "blvckstd/uminmax.h"
+#include "blvckstd/common_types.h"
+
+// Marks the end of the free slot list, also bounds the number of slots
+#define SLOTMAP_NO_SLOT UINT32_MAX
+
+/**
+ * @brief Handle to an item of a slotmap, only valid as long as the item exists
+ */
+typedef struct
+{
+  uint32_t index;
+  uint32_t generation;
+} slotmap_handle_t;
+
+/**
+ * @brief Slot of a slotmap, pointing to it's value or to the next free slot
+ */
+typedef struct
+{
+  uint32_t generation;
+
+  // Index within values while in use, next free slot otherwise
+  uint32_t target;
+} slotmap_slot_t;
+
+/**
+ * @brief Represents the slotmap, keeping track of it's
+ * slots, values and cleanup method
+ */
+typedef struct
+{
+  // Densely packed values, valid up to _length
+  void **values;
+
+  // Slot of each value, used to redirect a slot when it's value moves
+  uint32_t *_value_slots;
+
+  // Slots addressed by handles
+  slotmap_slot_t *_slots;
+
+  // Number of values and slots taken into use
+  size_t _length;
+  size_t _slot_count;
+
+  // Head of the free slot list, SLOTMAP_NO_SLOT if empty
+  uint32_t _free_head;
+
+  // Current allocated size of values and slots
+  size_t _array_size;
+
+  // Maximum number of slots the map can grow to
+  size_t _array_cap;
+
+  // Cleanup function for the values
+  clfn_t _cf;
+} slotmap_t;
+
+/**
+ * @brief Make a new, empty slotmap
+ *
+ * @param array_size Initial number of slots to allocate
+ * @param array_max_size Maximum number of slots, limited to SLOTMAP_NO_SLOT
+ * @param cf Cleanup function for the values
+ * @return slotmap_t* Pointer to the new slotmap
+ */
+slotmap_t *slotmap_make(size_t array_size, size_t array_max_size, clfn_t cf);
+
+/**
+ * @brief Insert a new item, reusing a free slot if available
+ *
+ * @param map Slotmap reference
+ * @param item Item to insert, can't be NULL
+ * @param handle Handle to the new item
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t slotmap_insert(slotmap_t *map, void *item, slotmap_handle_t *handle);
+
+/**
+ * @brief Get the item a handle refers to
+ *
+ * @param map Slotmap reference
+ * @param handle Handle to resolve
+ * @return void* Item, NULL if the handle is stale
+ */
+INLINED static void *slotmap_get(slotmap_t *map, slotmap_handle_t handle)
+{
+  if (handle.index >= map->_slot_count) return NULL;
+
+  slotmap_slot_t *slot = &map->_slots[handle.index];
+  if (slot->generation != handle.generation) return NULL;
+  return map->values[slot->target];
+}
+
+/**
+ * @brief Remove the item a handle refers to, invalidating all handles to it
+ *
+ * @param map Slotmap reference
+ * @param handle Handle of the item
+ * @param out Removed item output, cleaned up if set to NULL
+ * @return dynarr_result_t Operation result
+ */
+dynarr_result_t slotmap_remove(slotmap_t *map, slotmap_handle_t handle, void **out);
+
+/**
+ * @brief Get the number of items in the slotmap
+ *
+ * @param map Slotmap reference
+ */
+size_t slotmap_length(slotmap_t *map);
+
+/**
+ * @brief Clean up and remove all items, invalidating all handles
+ *
+ * @param map Slotmap to clear
+ */
+void slotmap_clear(slotmap_t *map);
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef tpool_h
+#define tpool_h
+
+/*
+  Work-stealing thread pool.
+
+  Every worker owns a Chase-Lev deque, which it pushes to and pops from at the
+  bottom without contention, while idle workers steal from the top of others.
+  Tasks submitted from outside of the pool go through a shared queue instead.
+  Threads waiting on a wait group run pending tasks meanwhile, so tasks may
+  submit and wait on further tasks themselves.
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "blvckstd/mman.h"
+#include "blvckstd/mpmc.h"
+#include "blvckstd/uminmax.h"
+#include "blvckstd/atomanip.h"
+#include "blvckstd/common_types.h"
+
+// Number of tasks a worker's deque holds, further tasks are run right away
+#define TPOOL_DEQUE_CAP 4096
+
+// Number of tasks the shared queue for outside submissions holds
+#define TPOOL_INJECT_CAP 4096
+
+// Number of fruitless searches before an idle worker goes to sleep
+#define TPOOL_SPIN_LIMIT 64
+
+// Time an idle worker sleeps before searching again, in microseconds
+#define TPOOL_SLEEP_US 1000
+
+// Number of chunks per thread parallel_for aims for if no grain size is given
+#define TPOOL_CHUNKS_PER_THREAD 4
+
+/**
+ * @brief Task routine
+ *
+ * @param arg Argument passed on submission
+ */
+typedef void (*tpool_task_f)(void *arg);
+
+/**
+ * @brief Routine processing a chunk of an index range
+ *
+ * @param arg Argument passed to parallel_for
+ * @param from Inclusive start index of the chunk
+ * @param to Exclusive end index of the chunk
+ */
+typedef void (*tpool_range_f)(void *arg, size_t from, size_t to);
+
+/**
+ * @brief Counts pending tasks, so that their completion can be awaited
+ */
+typedef struct
+{
+  volatile size_t _pending;
+} tpool_wait_t;
+
+/**
+ * @brief Represents a submitted task, owned by the pool until it has run
+ */
+typedef struct
+{
+  tpool_task_f fn;
+  void *arg;
+
+  // Wait group to notify on completion, NULL if not needed
+  tpool_wait_t *wg;
+} tpool_task_t;
+
+struct tpool;
+
+/**
+ * @brief Represents a worker thread and it's deque
+ */
+typedef struct
+{
+  // Addresses of the deque's tasks, indexed by position modulo the capacity
+  volatile size_t *tasks;
+
+  // Next position to steal from and next position to push to
+  volatile size_t _top;
+  volatile size_t _bottom;
+
+  pthread_t _thread;
+  bool _spawned;
+
+  struct tpool *_pool;
+  size_t _id;
+} tpool_worker_t;
+
+/**
+ * @brief Represents the thread pool, keeping track of it's workers
+ */
+typedef struct tpool
+{
+  // Workers, each running on their own thread
+  tpool_worker_t **workers;
+  size_t _num_workers;
+
+  // Tasks submitted from outside of the pool
+  mpmc_t *_inject;
+
+  // Workers exit once there's nothing left to do
+  volatile size_t _stop;
+
+  // Wakes up sleeping workers on submission
+  pthread_mutex_t _sleep_lock;
+  pthread_cond_t _sleep_cond;
+  volatile size_t _sleeping;
+} tpool_t;
+
+/**
+ * @brief Make a new thread pool and start it's workers
+ *
+ * @param num_threads Number of worker threads, 0 for one per online processor
+ * @return tpool_t* Pointer to the new pool, workers are stopped once all tasks have run on cleanup
+ */
+tpool_t *tpool_make(size_t num_threads);
+
+/**
+ * @brief Get the number of worker threads of a pool
+ *
+ * @param pool Pool reference
+ */
+size_t tpool_num_threads(tpool_t *pool);
+
+/**
+ * @brief Submit a task to be run by one of the workers
+ *
+ * @param pool Pool reference
+ * @param fn Task routine
+ * @param arg Argument to pass to the routine
+ * @param wg Wait group to add the task to, NULL if not needed
+ */
+void tpool_submit(tpool_t *pool, tpool_task_f fn, void *arg, tpool_wait_t *wg);
+
+/**
+ * @brief Run a routine over chunks of an index range in parallel, returns once all chunks are done
+ *
+ * @param pool Pool reference
+ * @param from Inclusive start index
+ * @param to Exclusive end index
+ * @param grain Number of indices per chunk, 0 to split evenly across all threads
+ * @param fn Routine processing a chunk
+ * @param arg Argument to pass to the routine
+ */
+void tpool_parallel_for(tpool_t *pool, size_t from, size_t to, size_t grain, tpool_range_f fn, void *arg);
+
+/*
+============================================================================
+                                Wait Groups
+============================================================================
+*/
+
+/**
+ * @brief Initialize a wait group without any pending tasks
+ *
+ * @param wg Wait group to initialize
+ */
+void tpool_wait_init(tpool_wait_t *wg);
+
+/**
+ * @brief Add pending tasks to a wait group, done automatically on submission
+ *
+ * @param wg Wait group reference
+ * @param count Number of tasks to add
+ */
+void tpool_wait_add(tpool_wait_t *wg, size_t count);
+
+/**
+ * @brief Mark a pending task of a wait group as done, done automatically after a task ran
+ *
+ * @param wg Wait group reference
+ */
+void tpool_wait_done(tpool_wait_t *wg);
+
+/**
+ * @brief Wait until a wait group has no more pending tasks, running pending tasks meanwhile
+ *
+ * @param pool Pool the tasks have been submitted to
+ * @param wg Wait group to wait on
+ */
+void tpool_wait(tpool_t *pool, tpool_wait_t *wg);
+
+#endif
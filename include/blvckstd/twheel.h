@@ -0,0 +1,124 @@
+#ifndef twheel_h
+#define twheel_h
+
+/*
+  Hierarchical timer wheel.
+
+  Timers are kept in slots of a few levels of wheels, where each level covers
+  a range of ticks TWHEEL_SLOTS times larger than the one below. Scheduling and
+  cancelling only ever link or unlink a timer, while timers on higher levels
+  are moved down a level whenever the wheel below completes a turn. Timers are
+  owned by the caller and linked intrusively, so there are no allocations.
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "blvckstd/mman.h"
+
+// Number of slots per level as a power of two
+#define TWHEEL_SLOT_BITS 6
+#define TWHEEL_SLOTS (1 << TWHEEL_SLOT_BITS)
+
+// Number of levels, timers further out than they cover wait on the top level
+#define TWHEEL_LEVELS 4
+
+/**
+ * @brief Routine of an expired timer
+ *
+ * @param arg Argument of the timer
+ */
+typedef void (*twheel_timer_f)(void *arg);
+
+/**
+ * @brief Represents a timer, owned by the caller and linked into a wheel while pending
+ */
+typedef struct twheel_timer
+{
+  twheel_timer_f fn;
+  void *arg;
+
+  // Tick to fire at
+  uint64_t _expires;
+
+  // Next timer of the slot and the link pointing to this timer, NULL if not pending
+  struct twheel_timer *_next;
+  struct twheel_timer **_pprev;
+} twheel_timer_t;
+
+/**
+ * @brief Represents the timer wheel, keeping track of it's slots and the current tick
+ */
+typedef struct
+{
+  // Pending timers of each slot of each level
+  twheel_timer_t *slots[TWHEEL_LEVELS][TWHEEL_SLOTS];
+
+  // Last tick that has been processed
+  uint64_t _now;
+
+  // Number of pending timers
+  size_t _pending;
+} twheel_t;
+
+/**
+ * @brief Make a new, empty timer wheel
+ *
+ * @param now Current tick
+ * @return twheel_t* Pointer to the new wheel, pending timers are detached on cleanup
+ */
+twheel_t *twheel_make(uint64_t now);
+
+/**
+ * @brief Initialize a timer which isn't pending yet
+ *
+ * @param timer Timer to initialize
+ * @param fn Routine to invoke once expired
+ * @param arg Argument to pass to the routine
+ */
+void twheel_timer_init(twheel_timer_t *timer, twheel_timer_f fn, void *arg);
+
+/**
+ * @brief Schedule a timer, rescheduling it if it's already pending
+ *
+ * @param wheel Wheel reference
+ * @param timer Initialized timer, has to stay valid until it fired or has been cancelled
+ * @param delay Number of ticks from now, at least one
+ */
+void twheel_schedule(twheel_t *wheel, twheel_timer_t *timer, uint64_t delay);
+
+/**
+ * @brief Cancel a pending timer
+ *
+ * @param wheel Wheel reference
+ * @param timer Timer to cancel
+ * @return true The timer has been cancelled
+ * @return false The timer hasn't been pending
+ */
+bool twheel_cancel(twheel_t *wheel, twheel_timer_t *timer);
+
+/**
+ * @brief Check whether a timer is pending
+ *
+ * @param timer Timer reference
+ */
+bool twheel_pending(twheel_timer_t *timer);
+
+/**
+ * @brief Advance the wheel, firing all timers that expired up to and including a tick
+ *
+ * @param wheel Wheel reference
+ * @param now Current tick, previous ticks are ignored
+ * @return size_t Number of timers fired
+ */
+size_t twheel_advance(twheel_t *wheel, uint64_t now);
+
+/**
+ * @brief Get the number of pending timers
+ *
+ * @param wheel Wheel reference
+ */
+size_t twheel_length(twheel_t *wheel);
+
+#endif
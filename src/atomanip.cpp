@@ -29,4 +29,40 @@ size_t atomic_increment(volatile size_t *target)
 size_t atomic_decrement(volatile size_t *target)
 {
   return atomic_add(target, -1);
+}
+
+bool atomic_cas(volatile size_t *target, const size_t expected, const size_t desired)
+{
+  #ifdef ESP8266
+  if (*target != expected) return false;
+  *target = desired;
+  return true;
+  #else
+  return __sync_bool_compare_and_swap(target, expected, desired);
+  #endif
+}
+
+size_t atomic_load_acquire(volatile size_t *target)
+{
+  #ifdef ESP8266
+  return *target;
+  #else
+  return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+  #endif
+}
+
+void atomic_store_release(volatile size_t *target, const size_t value)
+{
+  #ifdef ESP8266
+  *target = value;
+  #else
+  __atomic_store_n(target, value, __ATOMIC_RELEASE);
+  #endif
+}
+
+void atomic_fence()
+{
+  #ifndef ESP8266
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  #endif
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "blvckstd/bloom.h"
+
+/**
+ * @brief Clean up a no longer needed filter
+ */
+static void bloom_cleanup(mman_meta_t *ref)
+{
+  bloom_t *bloom = (bloom_t *) ref->ptr;
+  mman_dealloc(bloom->_block_mem);
+}
+
+bloom_t *bloom_make(size_t item_cap, size_t bits_per_item)
+{
+  scptr bloom_t *bloom = (bloom_t *) mman_alloc(sizeof(bloom_t), 1, bloom_cleanup);
+
+  // Constrain to have at least one block
+  size_t bits = item_cap * bits_per_item;
+  size_t blocks = (bits + BLOOM_BLOCK_BITS - 1) / BLOOM_BLOCK_BITS;
+  if (blocks == 0) blocks = 1;
+
+  // The optimal number of hashes is bits per item times ln(2)
+  size_t num_hashes = (size_t) lround(bits_per_item * M_LN2);
+  if (num_hashes < BLOOM_MIN_HASHES) num_hashes = BLOOM_MIN_HASHES;
+  if (num_hashes > BLOOM_MAX_HASHES) num_hashes = BLOOM_MAX_HASHES;
+
+  bloom->_block_count = blocks; // No freeing
+  bloom->_num_hashes = num_hashes; // No freeing
+  bloom->_item_count = 0; // No freeing
+
+  // Allocate one more block than needed and align to the cache line
+  size_t block_size = sizeof(uint64_t) * BLOOM_BLOCK_WORDS;
+  bloom->_block_mem = mman_calloc(block_size, blocks + 1, NULL); // needs mman freeing
+  uintptr_t addr = (uintptr_t) bloom->_block_mem;
+  bloom->blocks = (uint64_t *) ((addr + block_size - 1) & ~((uintptr_t) block_size - 1)); // No freeing
+
+  return (bloom_t *) mman_ref(bloom);
+}
+
+void bloom_add(bloom_t *bloom, const char *key)
+{
+  bloom_add_hash(bloom, htable_hash_raw(key));
+}
+
+bool bloom_may_contain(bloom_t *bloom, const char *key)
+{
+  return bloom_may_contain_hash(bloom, htable_hash_raw(key));
+}
+
+void bloom_clear(bloom_t *bloom)
+{
+  memset(bloom->blocks, 0, sizeof(uint64_t) * BLOOM_BLOCK_WORDS * bloom->_block_count);
+  bloom->_item_count = 0;
+}
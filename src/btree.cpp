@@ -0,0 +1,532 @@
+#include "blvckstd/btree.h"
+
+ENUM_LUT_FULL_IMPL(btree_result, _EVALS_BTREE_RESULT);
+
+/**
+ * @brief Clean up a node and all of it's descendants
+ */
+static void btree_node_cleanup(btree_node_t *node, clfn_t cf)
+{
+  for (size_t i = 0; i < node->_count; i++)
+  {
+    mman_dealloc(node->keys[i]);
+    if (node->_leaf && cf) cf(node->values[i]);
+  }
+
+  if (!node->_leaf)
+  {
+    for (size_t i = 0; i <= node->_count; i++)
+      btree_node_cleanup(node->children[i], cf);
+  }
+
+  mman_dealloc(node);
+}
+
+/**
+ * @brief Clean up a no longer needed btree struct and it's nodes
+ */
+static void btree_cleanup(mman_meta_t *ref)
+{
+  btree_t *tree = (btree_t *) ref->ptr;
+  btree_node_cleanup(tree->root, tree->_cf);
+}
+
+/**
+ * @brief Allocate a new, empty node
+ */
+static btree_node_t *btree_node_make(bool leaf)
+{
+  btree_node_t *node = (btree_node_t *) mman_alloc(sizeof(btree_node_t), 1, NULL); // needs mman freeing
+  node->_count = 0;
+  node->_leaf = leaf;
+  node->_next = NULL;
+  return node;
+}
+
+btree_t *btree_make(clfn_t cf)
+{
+  scptr btree_t *tree = (btree_t *) mman_alloc(sizeof(btree_t), 1, btree_cleanup);
+
+  tree->root = btree_node_make(true); // needs mman freeing
+  tree->_item_count = 0; // No freeing
+  tree->_cf = cf; // No freeing
+
+  return (btree_t *) mman_ref(tree);
+}
+
+/*
+============================================================================
+                                 Searching
+============================================================================
+*/
+
+/**
+ * @brief Find the first index within a node whose key is not below the given key
+ */
+INLINED static size_t btree_node_lower(btree_node_t *node, const char *key)
+{
+  size_t lo = 0, hi = node->_count;
+  while (lo < hi)
+  {
+    size_t mid = (lo + hi) / 2;
+    if (strcmp(node->keys[mid], key) < 0) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/**
+ * @brief Find the first index within a node whose key is above the given key,
+ * which is also the index of the child a key belongs into
+ */
+INLINED static size_t btree_node_upper(btree_node_t *node, const char *key)
+{
+  size_t lo = 0, hi = node->_count;
+  while (lo < hi)
+  {
+    size_t mid = (lo + hi) / 2;
+    if (strcmp(node->keys[mid], key) <= 0) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/**
+ * @brief Descend to the leaf a key belongs into
+ */
+INLINED static btree_node_t *btree_find_leaf(btree_t *tree, const char *key)
+{
+  btree_node_t *node = tree->root;
+  while (!node->_leaf)
+    node = node->children[btree_node_upper(node, key)];
+  return node;
+}
+
+btree_result_t btree_fetch(btree_t *tree, const char *key, void **output)
+{
+  btree_node_t *leaf = btree_find_leaf(tree, key);
+  size_t index = btree_node_lower(leaf, key);
+
+  if (index == leaf->_count || strcmp(leaf->keys[index], key) != 0)
+    return BTREE_KEY_NOT_FOUND;
+
+  if (output) *output = leaf->values[index];
+  return BTREE_SUCCESS;
+}
+
+bool btree_contains(btree_t *tree, const char *key)
+{
+  return btree_fetch(tree, key, NULL) == BTREE_SUCCESS;
+}
+
+size_t btree_count(btree_t *tree)
+{
+  return tree->_item_count;
+}
+
+/*
+============================================================================
+                                 Insertion
+============================================================================
+*/
+
+/**
+ * @brief Insert a key and either a value or a right child at an index, splitting
+ * the node if it's full, where the lower half stays in the node
+ *
+ * @param node Node to insert into
+ * @param index Index of the new key
+ * @param key Key to insert, ownership is transferred
+ * @param item Value for leaves, right child of the key for inner nodes
+ * @param sep Separator output, owned by the caller, only set on splits
+ * @param split Right half output, NULL if the node didn't split
+ */
+static void btree_node_insert(btree_node_t *node, size_t index, char *key, void *item, char **sep, btree_node_t **split)
+{
+  *split = NULL;
+
+  // Room left, shift the tail and insert in place
+  if (node->_count < BTREE_MAX_KEYS)
+  {
+    memmove(&node->keys[index + 1], &node->keys[index], sizeof(char *) * (node->_count - index));
+
+    if (node->_leaf)
+    {
+      memmove(&node->values[index + 1], &node->values[index], sizeof(void *) * (node->_count - index));
+      node->values[index] = item;
+    }
+    else
+    {
+      memmove(&node->children[index + 2], &node->children[index + 1], sizeof(btree_node_t *) * (node->_count - index));
+      node->children[index + 1] = (btree_node_t *) item;
+    }
+
+    node->keys[index] = key;
+    node->_count++;
+    return;
+  }
+
+  // Build the overfull sequence of keys and items
+  char *keys[BTREE_MAX_KEYS + 1];
+  void *items[BTREE_MAX_KEYS + 2];
+
+  // Inner nodes have one more child than keys, which leads the items
+  size_t offs = node->_leaf ? 0 : 1;
+  void **node_items = node->_leaf ? node->values : (void **) node->children;
+
+  memcpy(keys, node->keys, sizeof(char *) * index);
+  memcpy(&keys[index + 1], &node->keys[index], sizeof(char *) * (BTREE_MAX_KEYS - index));
+  keys[index] = key;
+
+  memcpy(items, node_items, sizeof(void *) * (index + offs));
+  memcpy(&items[index + offs + 1], &node_items[index + offs], sizeof(void *) * (BTREE_MAX_KEYS - index));
+  items[index + offs] = item;
+
+  btree_node_t *right = btree_node_make(node->_leaf);
+  void **right_items = right->_leaf ? right->values : (void **) right->children;
+  size_t left_count = (BTREE_MAX_KEYS + 1) / 2;
+
+  // Leaves copy their first right key up and link the new leaf
+  if (node->_leaf)
+  {
+    node->_count = left_count;
+    right->_count = BTREE_MAX_KEYS + 1 - left_count;
+
+    memcpy(node->keys, keys, sizeof(char *) * node->_count);
+    memcpy(node->values, items, sizeof(void *) * node->_count);
+    memcpy(right->keys, &keys[left_count], sizeof(char *) * right->_count);
+    memcpy(right_items, &items[left_count], sizeof(void *) * right->_count);
+
+    right->_next = node->_next;
+    node->_next = right;
+    *sep = strclone(right->keys[0]);
+  }
+
+  // Inner nodes move their middle key up
+  else
+  {
+    node->_count = left_count;
+    right->_count = BTREE_MAX_KEYS - left_count;
+
+    memcpy(node->keys, keys, sizeof(char *) * node->_count);
+    memcpy(node->children, items, sizeof(btree_node_t *) * (node->_count + 1));
+    memcpy(right->keys, &keys[left_count + 1], sizeof(char *) * right->_count);
+    memcpy(right_items, &items[left_count + 1], sizeof(void *) * (right->_count + 1));
+
+    *sep = keys[left_count];
+  }
+
+  *split = right;
+}
+
+/**
+ * @brief Insert into the subtree of a node
+ *
+ * @param node Root of the subtree
+ * @param key Key to insert
+ * @param elem Value to insert
+ * @param sep Separator output, only set on splits
+ * @param split Right half output, NULL if the node didn't split
+ */
+static btree_result_t btree_insert_rec(btree_node_t *node, const char *key, void *elem, char **sep, btree_node_t **split)
+{
+  *split = NULL;
+
+  if (node->_leaf)
+  {
+    size_t index = btree_node_lower(node, key);
+    if (index < node->_count && strcmp(node->keys[index], key) == 0)
+      return BTREE_KEY_ALREADY_EXISTS;
+
+    btree_node_insert(node, index, strclone(key), elem, sep, split);
+    return BTREE_SUCCESS;
+  }
+
+  size_t index = btree_node_upper(node, key);
+
+  char *child_sep = NULL;
+  btree_node_t *child_split = NULL;
+  btree_result_t res = btree_insert_rec(node->children[index], key, elem, &child_sep, &child_split);
+
+  // The child split, take over it's separator and right half
+  if (child_split)
+    btree_node_insert(node, index, child_sep, child_split, sep, split);
+
+  return res;
+}
+
+btree_result_t btree_insert(btree_t *tree, const char *key, void *elem)
+{
+  // Tried to insert a null value
+  if (!elem) return BTREE_NULL_VALUE;
+
+  // Key too long
+  if (strlen(key) > BTREE_MAX_KEYLEN) return BTREE_KEY_TOO_LONG;
+
+  char *sep = NULL;
+  btree_node_t *split = NULL;
+  btree_result_t res = btree_insert_rec(tree->root, key, elem, &sep, &split);
+  if (res != BTREE_SUCCESS) return res;
+
+  // The root split, grow by one level
+  if (split)
+  {
+    btree_node_t *root = btree_node_make(false);
+    root->_count = 1;
+    root->keys[0] = sep;
+    root->children[0] = tree->root;
+    root->children[1] = split;
+    tree->root = root;
+  }
+
+  tree->_item_count++;
+  return BTREE_SUCCESS;
+}
+
+/*
+============================================================================
+                                  Removal
+============================================================================
+*/
+
+/**
+ * @brief Remove the key at an index as well as the value at the same index,
+ * or the child right of it for inner nodes, without freeing either
+ */
+static void btree_node_erase(btree_node_t *node, size_t index)
+{
+  memmove(&node->keys[index], &node->keys[index + 1], sizeof(char *) * (node->_count - index - 1));
+
+  if (node->_leaf)
+    memmove(&node->values[index], &node->values[index + 1], sizeof(void *) * (node->_count - index - 1));
+  else
+    memmove(&node->children[index + 1], &node->children[index + 2], sizeof(btree_node_t *) * (node->_count - index - 1));
+
+  node->_count--;
+}
+
+/**
+ * @brief Merge the child right of a parent's key into the child left of it
+ */
+static void btree_merge(btree_node_t *parent, size_t index)
+{
+  btree_node_t *left = parent->children[index];
+  btree_node_t *right = parent->children[index + 1];
+
+  if (left->_leaf)
+  {
+    memcpy(&left->keys[left->_count], right->keys, sizeof(char *) * right->_count);
+    memcpy(&left->values[left->_count], right->values, sizeof(void *) * right->_count);
+    left->_count += right->_count;
+    left->_next = right->_next;
+
+    // The separator is only a copy
+    mman_dealloc(parent->keys[index]);
+  }
+  else
+  {
+    // The separator moves down between both halves
+    left->keys[left->_count] = parent->keys[index];
+    memcpy(&left->keys[left->_count + 1], right->keys, sizeof(char *) * right->_count);
+    memcpy(&left->children[left->_count + 1], right->children, sizeof(btree_node_t *) * (right->_count + 1));
+    left->_count += right->_count + 1;
+  }
+
+  btree_node_erase(parent, index);
+  mman_dealloc(right);
+}
+
+/**
+ * @brief Refill a child which dropped below the minimum number of keys, either
+ * by borrowing from a sibling or by merging with it
+ */
+static void btree_rebalance(btree_node_t *parent, size_t index)
+{
+  btree_node_t *child = parent->children[index];
+  btree_node_t *left = index > 0 ? parent->children[index - 1] : NULL;
+  btree_node_t *right = index < parent->_count ? parent->children[index + 1] : NULL;
+
+  // Borrow the left sibling's last item
+  if (left && left->_count > BTREE_MIN_KEYS)
+  {
+    memmove(&child->keys[1], child->keys, sizeof(char *) * child->_count);
+
+    if (child->_leaf)
+    {
+      memmove(&child->values[1], child->values, sizeof(void *) * child->_count);
+      child->keys[0] = left->keys[left->_count - 1];
+      child->values[0] = left->values[left->_count - 1];
+
+      mman_dealloc(parent->keys[index - 1]);
+      parent->keys[index - 1] = strclone(child->keys[0]);
+    }
+    else
+    {
+      memmove(&child->children[1], child->children, sizeof(btree_node_t *) * (child->_count + 1));
+      child->keys[0] = parent->keys[index - 1];
+      child->children[0] = left->children[left->_count];
+      parent->keys[index - 1] = left->keys[left->_count - 1];
+    }
+
+    left->_count--;
+    child->_count++;
+    return;
+  }
+
+  // Borrow the right sibling's first item
+  if (right && right->_count > BTREE_MIN_KEYS)
+  {
+    if (child->_leaf)
+    {
+      child->keys[child->_count] = right->keys[0];
+      child->values[child->_count] = right->values[0];
+      memmove(right->keys, &right->keys[1], sizeof(char *) * (right->_count - 1));
+      memmove(right->values, &right->values[1], sizeof(void *) * (right->_count - 1));
+
+      mman_dealloc(parent->keys[index]);
+      parent->keys[index] = strclone(right->keys[0]);
+    }
+    else
+    {
+      child->keys[child->_count] = parent->keys[index];
+      child->children[child->_count + 1] = right->children[0];
+      parent->keys[index] = right->keys[0];
+      memmove(right->keys, &right->keys[1], sizeof(char *) * (right->_count - 1));
+      memmove(right->children, &right->children[1], sizeof(btree_node_t *) * right->_count);
+    }
+
+    right->_count--;
+    child->_count++;
+    return;
+  }
+
+  // Neither sibling can spare an item, merge with one of them
+  btree_merge(parent, left ? index - 1 : index);
+}
+
+/**
+ * @brief Remove from the subtree of a node, rebalancing on the way back up
+ */
+static btree_result_t btree_remove_rec(btree_node_t *node, const char *key, clfn_t cf)
+{
+  if (node->_leaf)
+  {
+    size_t index = btree_node_lower(node, key);
+    if (index == node->_count || strcmp(node->keys[index], key) != 0)
+      return BTREE_KEY_NOT_FOUND;
+
+    // Separators equal to this key stay valid, they're copies
+    mman_dealloc(node->keys[index]);
+    if (cf) cf(node->values[index]);
+    btree_node_erase(node, index);
+    return BTREE_SUCCESS;
+  }
+
+  size_t index = btree_node_upper(node, key);
+  btree_result_t res = btree_remove_rec(node->children[index], key, cf);
+
+  if (res == BTREE_SUCCESS && node->children[index]->_count < BTREE_MIN_KEYS)
+    btree_rebalance(node, index);
+
+  return res;
+}
+
+btree_result_t btree_remove(btree_t *tree, const char *key)
+{
+  btree_result_t res = btree_remove_rec(tree->root, key, tree->_cf);
+  if (res != BTREE_SUCCESS) return res;
+
+  // The root ran out of keys, shrink by one level
+  btree_node_t *root = tree->root;
+  if (!root->_leaf && root->_count == 0)
+  {
+    tree->root = root->children[0];
+    mman_dealloc(root);
+  }
+
+  tree->_item_count--;
+  return BTREE_SUCCESS;
+}
+
+/*
+============================================================================
+                                 Iteration
+============================================================================
+*/
+
+/**
+ * @brief Position an iterator within a leaf without any bounds
+ */
+INLINED static void btree_iter_init(btree_iter_t *iter, btree_node_t *leaf, size_t index)
+{
+  iter->_leaf = leaf;
+  iter->_index = index;
+  iter->_end = NULL;
+  iter->_prefix = NULL;
+  iter->_prefix_len = 0;
+}
+
+void btree_first(btree_t *tree, btree_iter_t *iter)
+{
+  btree_node_t *node = tree->root;
+  while (!node->_leaf)
+    node = node->children[0];
+
+  btree_iter_init(iter, node, 0);
+}
+
+void btree_lower_bound(btree_t *tree, const char *key, btree_iter_t *iter)
+{
+  btree_node_t *leaf = btree_find_leaf(tree, key);
+  btree_iter_init(iter, leaf, btree_node_lower(leaf, key));
+}
+
+void btree_upper_bound(btree_t *tree, const char *key, btree_iter_t *iter)
+{
+  btree_node_t *leaf = btree_find_leaf(tree, key);
+  btree_iter_init(iter, leaf, btree_node_upper(leaf, key));
+}
+
+void btree_range(btree_t *tree, const char *from, const char *to, btree_iter_t *iter)
+{
+  if (from) btree_lower_bound(tree, from, iter);
+  else btree_first(tree, iter);
+
+  iter->_end = to;
+}
+
+void btree_prefix(btree_t *tree, const char *prefix, btree_iter_t *iter)
+{
+  btree_lower_bound(tree, prefix, iter);
+  iter->_prefix = prefix;
+  iter->_prefix_len = strlen(prefix);
+}
+
+bool btree_iter_next(btree_iter_t *iter, const char **key, void **value)
+{
+  // Advance over exhausted leaves, a position may lie past a leaf's end
+  while (iter->_leaf && iter->_index >= iter->_leaf->_count)
+  {
+    iter->_leaf = iter->_leaf->_next;
+    iter->_index = 0;
+  }
+
+  if (!iter->_leaf) return false;
+
+  const char *curr = iter->_leaf->keys[iter->_index];
+
+  // Left the range, keys only ever grow from here on
+  if (
+    (iter->_end && strcmp(curr, iter->_end) >= 0)
+    || (iter->_prefix && strncmp(curr, iter->_prefix, iter->_prefix_len) != 0)
+  )
+  {
+    iter->_leaf = NULL;
+    return false;
+  }
+
+  if (key) *key = curr;
+  if (value) *value = iter->_leaf->values[iter->_index];
+  iter->_index++;
+  return true;
+}
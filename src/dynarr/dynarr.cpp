@@ -0,0 +1,515 @@
+#include "blvckstd/dynarr.h"
+
+ENUM_LUT_FULL_IMPL(dynarr_result, _EVALS_DYNARR_RES);
+
+/**
+ * @brief Clean up a no longer needed dynarr struct and all of it's items
+ */
+INLINED static void dynarr_cleanup(mman_meta_t *ref)
+{
+  dynarr_t *dynarr = (dynarr_t *) ref->ptr;
+
+  // Clean up items if applicable
+  if (dynarr->_cf)
+  {
+    for (size_t i = 0; i < dynarr->_array_size; i++)
+      dynarr->_cf(dynarr->items[i]);
+  }
+
+  // Dealloc the item pointers and their occupancy, if they moved to the heap
+  if (dynarr->items != dynarr->_inline_items)
+  {
+    mman_dealloc(dynarr->items);
+    mman_dealloc(dynarr->_occupied);
+  }
+}
+
+/**
+ * @brief Get the number of occupancy words needed for a number of slots
+ */
+INLINED static size_t dynarr_occupancy_words(size_t slots)
+{
+  return (slots + 63) / 64;
+}
+
+/**
+ * @brief Keep track of whether a slot is occupied
+ */
+INLINED static void dynarr_mark(dynarr_t *arr, size_t index, bool occupied)
+{
+  uint64_t bit = (uint64_t) 1 << (index % 64);
+
+  if (occupied)
+  {
+    arr->_occupied[index / 64] |= bit;
+    return;
+  }
+
+  arr->_occupied[index / 64] &= ~bit;
+  if (index < arr->_free_hint) arr->_free_hint = index;
+}
+
+/**
+ * @brief Find the lowest free slot, starting at the hint and skipping 64 occupied slots at a time
+ *
+ * @param arr Array reference
+ * @param index Index output
+ * @return true A free slot has been found
+ * @return false All slots are occupied
+ */
+static bool dynarr_find_free(dynarr_t *arr, size_t *index)
+{
+  size_t words = dynarr_occupancy_words(arr->_array_size);
+
+  for (size_t w = arr->_free_hint / 64; w < words; w++)
+  {
+    uint64_t free = ~arr->_occupied[w];
+
+    // Slots below the hint are known to be occupied
+    if (w == arr->_free_hint / 64)
+      free &= ~(uint64_t) 0 << (arr->_free_hint % 64);
+
+    if (!free) continue;
+
+    // Bits past the last slot are never set, stop there
+    size_t i = w * 64 + __builtin_ctzll(free);
+    if (i >= arr->_array_size) break;
+
+    *index = i;
+    return true;
+  }
+
+  arr->_free_hint = arr->_array_size;
+  return false;
+}
+
+dynarr_t *dynarr_make_mmf(size_t array_size)
+{
+  return dynarr_make(array_size, array_size, mman_dealloc_nr);
+}
+
+dynarr_t *dynarr_make_mm(size_t array_size, size_t array_max_size)
+{
+  return dynarr_make(array_size, array_max_size, mman_dealloc_nr);
+}
+
+dynarr_t *dynarr_make(size_t array_size, size_t array_max_size, clfn_t cf)
+{
+  scptr dynarr_t *res = (dynarr_t *) mman_alloc(sizeof(dynarr_t), 1, dynarr_cleanup);
+
+  res->_array_cap = array_max_size; // no freeing
+  res->_array_size = array_size; // no freeing
+  res->_cf = cf; // no freeing
+
+  // Small arrays keep their slots inline, saving two allocations
+  if (array_size <= DYNARR_INLINE_SLOTS)
+  {
+    res->items = res->_inline_items; // no freeing
+    res->_occupied = &res->_inline_occupied; // no freeing
+  }
+  else
+  {
+    res->items = (void **) mman_alloc(sizeof(void *), array_size, NULL); // needs mman freeing
+    res->_occupied = (uint64_t *) mman_alloc(sizeof(uint64_t), dynarr_occupancy_words(array_size), NULL); // needs mman freeing
+  }
+
+  // Initialize all slots to NULL, they start out free
+  for (size_t i = 0; i < array_size; i++)
+    res->items[i] = NULL;
+
+  memset(res->_occupied, 0, sizeof(uint64_t) * dynarr_occupancy_words(array_size));
+  res->_inline_occupied = 0; // no freeing
+  res->_free_hint = 0; // no freeing
+
+  res->_dense = false; // no freeing
+  res->_length = 0; // no freeing
+
+  res->_growth.mode = DYNARR_GM_FACTOR; // no freeing
+  res->_growth.factor = 2; // no freeing
+  res->_deferred_size = 0; // no freeing
+
+  return (dynarr_t *) mman_ref(res);
+}
+
+dynarr_t *dynarr_make_ex(size_t array_size, size_t array_max_size, clfn_t cf, dynarr_growth_t growth)
+{
+  // Start out without slots, the first push allocates them
+  dynarr_t *res = dynarr_make(0, array_max_size, cf);
+  res->_growth = growth;
+  res->_deferred_size = array_size < array_max_size ? array_size : array_max_size;
+  return res;
+}
+
+dynarr_t *dynarr_make_dense(size_t array_size, size_t array_max_size, clfn_t cf)
+{
+  dynarr_t *res = dynarr_make(array_size, array_max_size, cf);
+  res->_dense = true;
+  return res;
+}
+
+INLINED static void dynarr_resize_arr(dynarr_t *arr, size_t new_size)
+{
+  size_t old_words = dynarr_occupancy_words(arr->_array_size);
+  size_t new_words = dynarr_occupancy_words(new_size);
+  bool is_inline = arr->items == arr->_inline_items;
+
+  // Move back inline, dropped slots have been free
+  if (!is_inline && new_size <= DYNARR_INLINE_SLOTS)
+  {
+    memcpy(arr->_inline_items, arr->items, sizeof(void *) * new_size);
+    arr->_inline_occupied = arr->_occupied[0];
+
+    mman_dealloc(arr->items);
+    mman_dealloc(arr->_occupied);
+    arr->items = arr->_inline_items;
+    arr->_occupied = &arr->_inline_occupied;
+  }
+
+  // Move out to the heap, a single occupancy word covers all inline slots
+  else if (is_inline && new_size > DYNARR_INLINE_SLOTS)
+  {
+    void **items = (void **) mman_alloc(sizeof(void *), new_size, NULL);
+    memcpy(items, arr->items, sizeof(void *) * arr->_array_size);
+
+    uint64_t *occupied = (uint64_t *) mman_calloc(sizeof(uint64_t), new_words, NULL);
+    occupied[0] = arr->_inline_occupied;
+
+    arr->items = items;
+    arr->_occupied = occupied;
+  }
+
+  // Resize memory block of the array and it's occupancy, dropped slots have been free
+  else if (!is_inline)
+  {
+    arr->items = (void **) mman_realloc((void **) &arr->items, sizeof(void *), new_size)->ptr;
+
+    if (new_words != old_words)
+    {
+      arr->_occupied = (uint64_t *) mman_realloc((void **) &arr->_occupied, sizeof(uint64_t), new_words)->ptr;
+      if (new_words > old_words)
+        memset(&arr->_occupied[old_words], 0, sizeof(uint64_t) * (new_words - old_words));
+    }
+  }
+
+  // Initialize new slots, they are free
+  for (size_t i = arr->_array_size; i < new_size; i++)
+    arr->items[i] = NULL;
+
+  // Keep track of the new size
+  arr->_array_size = new_size;
+  if (arr->_free_hint > new_size) arr->_free_hint = new_size;
+  if (new_size >= arr->_deferred_size) arr->_deferred_size = 0;
+}
+
+/**
+ * @brief Calculate the next size according to the growth policy
+ */
+static size_t dynarr_next_size(dynarr_t *arr, size_t min_size)
+{
+  size_t size = arr->_array_size;
+  size_t new_size = min_size;
+
+  switch (arr->_growth.mode)
+  {
+    case DYNARR_GM_FACTOR:
+      new_size = (size_t) (size * arr->_growth.factor);
+      break;
+
+    case DYNARR_GM_CHUNK:
+      new_size = size + arr->_growth.chunk;
+      break;
+
+    case DYNARR_GM_CUSTOM:
+      new_size = arr->_growth.custom(size, min_size);
+      break;
+  }
+
+  // The first growth of a deferred array allocates it's requested size
+  if (new_size < arr->_deferred_size) new_size = arr->_deferred_size;
+
+  // Constrain to [min_size, cap]
+  if (new_size < min_size) new_size = min_size;
+  if (new_size > arr->_array_cap) new_size = arr->_array_cap;
+  return new_size;
+}
+
+static bool dynarr_try_resize(dynarr_t *arr)
+{
+  // Can't go any further
+  if (arr->_array_size >= arr->_array_cap)
+    return false;
+
+  // Resized
+  dynarr_resize_arr(arr, dynarr_next_size(arr, arr->_array_size + 1));
+  return true;
+}
+
+void dynarr_grow_by_factor(dynarr_t *arr, double factor)
+{
+  arr->_growth.mode = DYNARR_GM_FACTOR;
+  arr->_growth.factor = factor;
+}
+
+void dynarr_grow_by_chunk(dynarr_t *arr, size_t chunk)
+{
+  arr->_growth.mode = DYNARR_GM_CHUNK;
+  arr->_growth.chunk = chunk;
+}
+
+void dynarr_grow_custom(dynarr_t *arr, dynarr_growth_f custom)
+{
+  arr->_growth.mode = DYNARR_GM_CUSTOM;
+  arr->_growth.custom = custom;
+}
+
+dynarr_result_t dynarr_reserve(dynarr_t *arr, size_t num_slots)
+{
+  if (num_slots > arr->_array_cap) return DYNARR_FULL;
+
+  if (num_slots > arr->_array_size)
+    dynarr_resize_arr(arr, num_slots);
+
+  return DYNARR_SUCCESS;
+}
+
+void dynarr_shrink_to_fit(dynarr_t *arr)
+{
+  // Find the end of the highest occupied word, then the highest occupied slot within it
+  size_t used = 0;
+  for (size_t w = dynarr_occupancy_words(arr->_array_size); w-- > 0;)
+  {
+    uint64_t occupied = arr->_occupied[w];
+    if (!occupied) continue;
+
+    used = w * 64 + 64 - __builtin_clzll(occupied);
+    break;
+  }
+
+  if (used < arr->_array_size)
+    dynarr_resize_arr(arr, used);
+}
+
+dynarr_result_t dynarr_push(dynarr_t *arr, void *item, size_t *slot)
+{
+  // Dense arrays have no holes to fill, always append
+  size_t index;
+  if (arr->_dense)
+  {
+    if (!item) return DYNARR_NULL_ITEM;
+
+    index = arr->_length;
+    if (index == arr->_array_size && !dynarr_try_resize(arr))
+      return DYNARR_FULL;
+
+    arr->_length++;
+  }
+
+  // Fill the lowest hole, otherwise append into newly grown slots
+  else if (!dynarr_find_free(arr, &index))
+  {
+    index = arr->_array_size;
+
+    // No more free slots
+    if (!dynarr_try_resize(arr))
+      return DYNARR_FULL;
+  }
+
+  // Set item
+  arr->items[index] = item;
+  dynarr_mark(arr, index, item != NULL);
+  if (item) arr->_free_hint = index + 1;
+
+  if (slot) *slot = index;
+  return DYNARR_SUCCESS;
+}
+
+dynarr_result_t dynarr_set_at(dynarr_t *arr, size_t index, void *item)
+{
+  // Index range check, dense arrays can only replace existing items
+  if (index < 0 || index >= (arr->_dense ? arr->_length : arr->_array_size)) return DYNARR_INDEX_NOT_FOUND;
+  if (arr->_dense && !item) return DYNARR_NULL_ITEM;
+
+  // Free old entry, if any
+  void **slot = &(arr->items[index]);
+  if (*slot && arr->_cf) arr->_cf(*slot);
+
+  *slot = item;
+  dynarr_mark(arr, index, item != NULL);
+  return DYNARR_SUCCESS;
+}
+
+dynarr_result_t dynarr_remove_at(dynarr_t *arr, size_t index, void **out)
+{
+  // Range check
+  if (index < 0 || index >= (arr->_dense ? arr->_length : arr->_array_size)) return DYNARR_INDEX_NOT_FOUND;
+
+  // Write pointer to output buffer
+  void **slot = &(arr->items[index]);
+  if (out) *out = *slot;
+
+  // Close the gap, the last slot becomes free
+  if (arr->_dense)
+  {
+    memmove(slot, slot + 1, sizeof(void *) * (arr->_length - index - 1));
+    index = --arr->_length;
+    slot = &(arr->items[index]);
+  }
+
+  // Clear slot
+  *slot = NULL;
+  dynarr_mark(arr, index, false);
+  return DYNARR_SUCCESS;
+}
+
+dynarr_result_t dynarr_pop(dynarr_t *arr, void **out)
+{
+  if (arr->_dense)
+  {
+    if (arr->_length == 0) return DYNARR_EMPTY;
+    return dynarr_remove_at(arr, arr->_length - 1, out);
+  }
+
+  // Search the highest occupied slot, 64 slots at a time
+  for (size_t w = dynarr_occupancy_words(arr->_array_size); w-- > 0;)
+  {
+    uint64_t occupied = arr->_occupied[w];
+    if (occupied)
+      return dynarr_remove_at(arr, w * 64 + 63 - __builtin_clzll(occupied), out);
+  }
+
+  return DYNARR_EMPTY;
+}
+
+char *dynarr_dump_hr(dynarr_t *arr, stringifier_t stringifier)
+{
+  // Allocate buffer for formatting strings into
+  scptr char *buf = (char *)mman_alloc(sizeof(char), 128, NULL);
+  size_t buf_offs = 0;
+
+  // Array start marker
+  if (!strfmt(&buf, &buf_offs, "[")) return NULL;
+
+  for (size_t i = 0; i < arr->_array_size; i++)
+  {
+    // Skip empty slots
+    void *item = arr->items[i];
+    if (!item) continue;
+
+    // Print slot string with quotes and comma-separators
+    if (!strfmt(
+      &buf, &buf_offs,
+      "%s\"%s\"",
+      i == 0 ? "" : ", ",
+      stringifier ? stringifier(item) : (char *) item
+    )) return NULL;
+  }
+
+  // Array end marker
+  if (!strfmt(&buf, &buf_offs, "]")) return NULL;
+  return (char *) mman_ref(buf);
+}
+
+INLINED static size_t dynarr_count_used_slots(dynarr_t *arr)
+{
+  // Count number of active slots, 64 at a time
+  size_t active_slots = 0;
+  size_t words = dynarr_occupancy_words(arr->_array_size);
+  for (size_t w = 0; w < words; w++)
+    active_slots += __builtin_popcountll(arr->_occupied[w]);
+
+  return active_slots;
+}
+
+/**
+ * @brief Collect the items and or indices of all active slots in ascending
+ * order, jumping from one set occupancy bit to the next
+ *
+ * @param arr Array to collect from
+ * @param items Items output, leave as NULL if not needed
+ * @param indices Indices output, leave as NULL if not needed
+ * @return size_t Number of collected slots
+ */
+static size_t dynarr_collect(dynarr_t *arr, void **items, size_t *indices)
+{
+  size_t num_collected = 0;
+  size_t words = dynarr_occupancy_words(arr->_array_size);
+
+  for (size_t w = 0; w < words; w++)
+  {
+    // Clear the lowest set bit after each visit
+    for (uint64_t occupied = arr->_occupied[w]; occupied; occupied &= occupied - 1)
+    {
+      size_t i = w * 64 + __builtin_ctzll(occupied);
+      if (items) items[num_collected] = arr->items[i];
+      if (indices) indices[num_collected] = i;
+      num_collected++;
+    }
+  }
+
+  return num_collected;
+}
+
+size_t dynarr_length(dynarr_t *arr)
+{
+  return arr->_dense ? arr->_length : dynarr_count_used_slots(arr);
+}
+
+size_t dynarr_as_array(dynarr_t *arr, void ***out)
+{
+  // No output buffer provided
+  if (!out) return 0;
+
+  // Create array
+  size_t active_slots = dynarr_length(arr);
+  scptr void **res = (void **) mman_alloc(sizeof(void *), active_slots + 1, NULL);
+
+  // Copy over pointers, dense arrays in one go
+  size_t res_index = 0;
+  if (arr->_dense)
+  {
+    memcpy(res, arr->items, sizeof(void *) * active_slots);
+    res_index = active_slots;
+  }
+  else
+    res_index = dynarr_collect(arr, res, NULL);
+
+  // Null-terminate array
+  res[res_index] = NULL;
+
+  *out = (void **) mman_ref(res);
+  return active_slots;
+}
+
+void dynarr_clear(dynarr_t *arr)
+{
+  // Dense arrays would shift on every removal, pop from the back instead
+  if (arr->_dense)
+  {
+    void *elem;
+    while (dynarr_pop(arr, &elem) == DYNARR_SUCCESS)
+      mman_dealloc(elem);
+    return;
+  }
+
+  // Visit the active slots of each word, removing only clears bits of the array's copy
+  size_t words = dynarr_occupancy_words(arr->_array_size);
+  for (size_t w = 0; w < words; w++)
+  {
+    for (uint64_t occupied = arr->_occupied[w]; occupied; occupied &= occupied - 1)
+    {
+      // Free this slot and deallocate
+      void *elem;
+      if (dynarr_remove_at(arr, w * 64 + __builtin_ctzll(occupied), &elem) == DYNARR_SUCCESS)
+        mman_dealloc(elem);
+    }
+  }
+}
+
+void dynarr_indices(dynarr_t *arr, size_t **active, size_t *num_active)
+{
+  *num_active = dynarr_length(arr);
+  *active = (size_t *) mman_alloc(sizeof(size_t), *num_active, NULL);
+
+  // Collect all active indices
+  dynarr_collect(arr, NULL, *active);
+}
\ No newline at end of file
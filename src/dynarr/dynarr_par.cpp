@@ -0,0 +1,176 @@
+#include "blvckstd/dynarr_par.h"
+#include "blvckstd/uminmax.h"
+
+/*
+============================================================================
+                                  Parallel
+============================================================================
+*/
+
+/**
+ * @brief State shared by all chunks of a parallel operation
+ */
+typedef struct
+{
+  dynarr_t *arr;
+  size_t grain;
+
+  // Either mapping or filtering
+  dynarr_map_f map;
+  dynarr_filter_f filter;
+  dynarr_reduce_f reduce;
+  void *arg;
+
+  // Results of each chunk, packed at the front of the chunk's range
+  void **results;
+  size_t *counts;
+
+  // Accumulator of each chunk
+  void **accs;
+
+  // Output position of each chunk and output array
+  size_t *offsets;
+  dynarr_t *out;
+} dynarr_par_t;
+
+/**
+ * @brief Get the number of slots which may hold items
+ */
+INLINED static size_t dynarr_par_slots(dynarr_t *arr)
+{
+  return arr->_dense ? arr->_length : arr->_array_size;
+}
+
+/**
+ * @brief Split the slots into as many chunks as the pool processes well
+ *
+ * @return size_t Number of chunks
+ */
+static size_t dynarr_par_split(dynarr_par_t *par, tpool_t *pool, size_t n)
+{
+  size_t target = tpool_num_threads(pool) * TPOOL_CHUNKS_PER_THREAD;
+  par->grain = u64_max((n + target - 1) / target, 1);
+  return (n + par->grain - 1) / par->grain;
+}
+
+static void dynarr_par_collect_routine(void *arg, size_t from, size_t to)
+{
+  dynarr_par_t *par = (dynarr_par_t *) arg;
+
+  // Pack this chunk's results to the front of it's range
+  size_t count = 0;
+  for (size_t i = from; i < to; i++)
+  {
+    void *item = par->arr->items[i];
+    if (!item) continue;
+
+    void *res = par->map ? par->map(item, par->arg) : (par->filter(item, par->arg) ? item : NULL);
+    if (res) par->results[from + count++] = res;
+  }
+
+  par->counts[from / par->grain] = count;
+}
+
+static void dynarr_par_copy_routine(void *arg, size_t from, size_t to)
+{
+  dynarr_par_t *par = (dynarr_par_t *) arg;
+
+  for (size_t c = from; c < to; c++)
+    memcpy(&par->out->items[par->offsets[c]], &par->results[c * par->grain], sizeof(void *) * par->counts[c]);
+}
+
+/**
+ * @brief Collect the results of mapping or filtering into a new dense array
+ */
+static dynarr_t *dynarr_par_collect(dynarr_par_t *par, tpool_t *pool, clfn_t cf)
+{
+  size_t n = dynarr_par_slots(par->arr);
+  size_t num_chunks = dynarr_par_split(par, pool, n);
+
+  scptr void **results = (void **) mman_alloc(sizeof(void *), n, NULL);
+  scptr size_t *counts = (size_t *) mman_alloc(sizeof(size_t), num_chunks, NULL);
+  scptr size_t *offsets = (size_t *) mman_alloc(sizeof(size_t), num_chunks, NULL);
+  par->results = results;
+  par->counts = counts;
+  par->offsets = offsets;
+
+  tpool_parallel_for(pool, 0, n, par->grain, dynarr_par_collect_routine, par);
+
+  // Chunks are written back to back, in order
+  size_t total = 0;
+  for (size_t c = 0; c < num_chunks; c++)
+  {
+    offsets[c] = total;
+    total += counts[c];
+  }
+
+  dynarr_t *out = dynarr_make_dense(total, u64_max(total, par->arr->_array_cap), cf);
+  par->out = out;
+  tpool_parallel_for(pool, 0, num_chunks, 1, dynarr_par_copy_routine, par);
+
+  // All slots are occupied
+  size_t words = (total + 63) / 64;
+  for (size_t w = 0; w < words; w++)
+    out->_occupied[w] = (w + 1) * 64 <= total ? ~(uint64_t) 0 : ((uint64_t) 1 << (total % 64)) - 1;
+
+  out->_length = total;
+  out->_free_hint = total;
+  return out;
+}
+
+dynarr_t *dynarr_par_map(dynarr_t *arr, tpool_t *pool, dynarr_map_f map, void *arg, clfn_t cf)
+{
+  dynarr_par_t par = {};
+  par.arr = arr;
+  par.map = map;
+  par.arg = arg;
+  return dynarr_par_collect(&par, pool, cf);
+}
+
+dynarr_t *dynarr_par_filter(dynarr_t *arr, tpool_t *pool, dynarr_filter_f filter, void *arg)
+{
+  dynarr_par_t par = {};
+  par.arr = arr;
+  par.filter = filter;
+  par.arg = arg;
+  return dynarr_par_collect(&par, pool, NULL);
+}
+
+static void dynarr_par_reduce_routine(void *arg, size_t from, size_t to)
+{
+  dynarr_par_t *par = (dynarr_par_t *) arg;
+
+  void **acc = &par->accs[from / par->grain];
+  for (size_t i = from; i < to; i++)
+  {
+    void *item = par->arr->items[i];
+    if (item) *acc = par->reduce(*acc, item, par->arg);
+  }
+}
+
+void *dynarr_par_reduce(dynarr_t *arr, tpool_t *pool, dynarr_identity_f make_identity, dynarr_reduce_f reduce, dynarr_reduce_f combine, void *arg)
+{
+  dynarr_par_t par = {};
+  par.arr = arr;
+  par.reduce = reduce;
+  par.arg = arg;
+
+  size_t n = dynarr_par_slots(arr);
+  size_t num_chunks = dynarr_par_split(&par, pool, n);
+  if (num_chunks == 0) return make_identity(arg);
+
+  // Every chunk owns it's accumulator, so reducers may mutate it
+  scptr void **accs = (void **) mman_alloc(sizeof(void *), num_chunks, NULL);
+  for (size_t c = 0; c < num_chunks; c++)
+    accs[c] = make_identity(arg);
+  par.accs = accs;
+
+  tpool_parallel_for(pool, 0, n, par.grain, dynarr_par_reduce_routine, &par);
+
+  // Combine in order, so combine doesn't have to be commutative
+  void *acc = accs[0];
+  for (size_t c = 1; c < num_chunks; c++)
+    acc = combine(acc, accs[c], arg);
+
+  return acc;
+}
@@ -0,0 +1,403 @@
+#include "blvckstd/dynarr.h"
+#include "blvckstd/uminmax.h"
+
+#include "blvckstd/tpool.h"
+
+// Ranges below this size are finished by insertion sort
+#define DYNARR_SORT_INSERTION_THRESH 16
+
+// Ranges below this size aren't worth a task of their own
+#define DYNARR_SORT_PARALLEL_THRESH 4096
+
+/*
+============================================================================
+                                  Packing
+============================================================================
+*/
+
+size_t dynarr_pack(dynarr_t *arr)
+{
+  // Dense arrays are packed by definition
+  if (arr->_dense) return arr->_length;
+
+  // Move all items to the front, keeping their order
+  size_t num_items = 0;
+  DYNARR_FOREACH(arr, it)
+  {
+    arr->items[it.index] = NULL;
+    arr->items[num_items++] = it.item;
+  }
+
+  // The occupancy becomes a prefix
+  size_t words = (arr->_array_size + 63) / 64;
+  for (size_t w = 0; w < words; w++)
+  {
+    if ((w + 1) * 64 <= num_items) arr->_occupied[w] = ~(uint64_t) 0;
+    else if (w * 64 >= num_items) arr->_occupied[w] = 0;
+    else arr->_occupied[w] = ((uint64_t) 1 << (num_items % 64)) - 1;
+  }
+
+  arr->_free_hint = num_items;
+  return num_items;
+}
+
+/*
+============================================================================
+                                 Introsort
+============================================================================
+*/
+
+INLINED static void dynarr_swap(void **a, void **b)
+{
+  void *tmp = *a;
+  *a = *b;
+  *b = tmp;
+}
+
+static void dynarr_insertion_sort(void **items, size_t n, dynarr_cmp_f cmp)
+{
+  for (size_t i = 1; i < n; i++)
+  {
+    void *item = items[i];
+    size_t j = i;
+    for (; j > 0 && cmp(items[j - 1], item) > 0; j--)
+      items[j] = items[j - 1];
+    items[j] = item;
+  }
+}
+
+static void dynarr_sift_down(void **items, size_t root, size_t n, dynarr_cmp_f cmp)
+{
+  for (size_t child; (child = 2 * root + 1) < n; root = child)
+  {
+    if (child + 1 < n && cmp(items[child], items[child + 1]) < 0) child++;
+    if (cmp(items[root], items[child]) >= 0) return;
+    dynarr_swap(&items[root], &items[child]);
+  }
+}
+
+static void dynarr_heap_sort(void **items, size_t n, dynarr_cmp_f cmp)
+{
+  for (size_t i = n / 2; i-- > 0;)
+    dynarr_sift_down(items, i, n, cmp);
+
+  for (size_t end = n; end-- > 1;)
+  {
+    dynarr_swap(&items[0], &items[end]);
+    dynarr_sift_down(items, 0, end, cmp);
+  }
+}
+
+/**
+ * @brief Quicksort with a median of three pivot, falling back to heapsort
+ * once the recursion gets too deep and to insertion sort on small ranges
+ */
+static void dynarr_introsort(void **items, size_t n, size_t depth, dynarr_cmp_f cmp)
+{
+  while (n > DYNARR_SORT_INSERTION_THRESH)
+  {
+    if (depth-- == 0)
+    {
+      dynarr_heap_sort(items, n, cmp);
+      return;
+    }
+
+    // Order first, middle and last, the median becomes the pivot
+    size_t mid = n / 2;
+    if (cmp(items[mid], items[0]) < 0) dynarr_swap(&items[mid], &items[0]);
+    if (cmp(items[n - 1], items[0]) < 0) dynarr_swap(&items[n - 1], &items[0]);
+    if (cmp(items[n - 1], items[mid]) < 0) dynarr_swap(&items[n - 1], &items[mid]);
+    void *pivot = items[mid];
+
+    // Hoare partitioning, the outer items act as sentinels
+    size_t i = 0, j = n - 1;
+    while (true)
+    {
+      while (cmp(items[++i], pivot) < 0);
+      while (cmp(items[--j], pivot) > 0);
+      if (i >= j) break;
+      dynarr_swap(&items[i], &items[j]);
+    }
+
+    // Recurse into the smaller half, loop on the larger one
+    size_t left = j + 1;
+    if (left < n - left)
+    {
+      dynarr_introsort(items, left, depth, cmp);
+      items += left;
+      n -= left;
+    }
+    else
+    {
+      dynarr_introsort(items + left, n - left, depth, cmp);
+      n = left;
+    }
+  }
+
+  dynarr_insertion_sort(items, n, cmp);
+}
+
+/**
+ * @brief Get the recursion depth limit for a number of items, 2 * log2(n)
+ */
+INLINED static size_t dynarr_sort_depth(size_t n)
+{
+  size_t depth = 0;
+  for (; n > 1; n >>= 1) depth += 2;
+  return depth;
+}
+
+void dynarr_sort(dynarr_t *arr, dynarr_cmp_f cmp)
+{
+  size_t n = dynarr_pack(arr);
+  dynarr_introsort(arr->items, n, dynarr_sort_depth(n), cmp);
+}
+
+/*
+============================================================================
+                                Radix Sorts
+============================================================================
+*/
+
+void dynarr_sort_radix(dynarr_t *arr, dynarr_radix_key_f key)
+{
+  size_t n = dynarr_pack(arr);
+  if (n < 2) return;
+
+  scptr uint64_t *keys = (uint64_t *) mman_alloc(sizeof(uint64_t), n, NULL);
+  scptr uint64_t *keys_tmp = (uint64_t *) mman_alloc(sizeof(uint64_t), n, NULL);
+  scptr void **items_tmp = (void **) mman_alloc(sizeof(void *), n, NULL);
+
+  // Extract all keys once
+  for (size_t i = 0; i < n; i++)
+    keys[i] = key(arr->items[i]);
+
+  void **src = arr->items, **dst = items_tmp;
+  uint64_t *ksrc = keys, *kdst = keys_tmp;
+
+  // Least significant byte first, every pass is stable
+  for (size_t shift = 0; shift < 64; shift += 8)
+  {
+    size_t counts[257] = { 0 };
+    for (size_t i = 0; i < n; i++)
+      counts[((ksrc[i] >> shift) & 0xFF) + 1]++;
+
+    // Skip bytes all keys share
+    if (counts[((ksrc[0] >> shift) & 0xFF) + 1] == n)
+      continue;
+
+    for (size_t b = 0; b < 256; b++)
+      counts[b + 1] += counts[b];
+
+    for (size_t i = 0; i < n; i++)
+    {
+      size_t pos = counts[(ksrc[i] >> shift) & 0xFF]++;
+      dst[pos] = src[i];
+      kdst[pos] = ksrc[i];
+    }
+
+    void **swap_items = src; src = dst; dst = swap_items;
+    uint64_t *swap_keys = ksrc; ksrc = kdst; kdst = swap_keys;
+  }
+
+  // An odd number of passes left the result in the scratch buffer
+  if (src != arr->items)
+    memcpy(arr->items, src, sizeof(void *) * n);
+}
+
+/**
+ * @brief Get the character of an item's string key at a depth, the
+ * key is known to be at least as long as the depth
+ */
+INLINED static int dynarr_radix_char(void *item, size_t depth, dynarr_radix_str_f key)
+{
+  return (unsigned char) key(item)[depth];
+}
+
+/**
+ * @brief Compare two items' string keys starting at a depth
+ */
+INLINED static int dynarr_radix_strcmp(void *a, void *b, size_t depth, dynarr_radix_str_f key)
+{
+  return strcmp(key(a) + depth, key(b) + depth);
+}
+
+/**
+ * @brief Most significant character first radix sort, where the keys of all
+ * items in range are known to share their first depth characters
+ */
+static void dynarr_radix_str_rec(void **items, void **tmp, size_t n, size_t depth, dynarr_radix_str_f key)
+{
+  // Small ranges are cheaper to finish by comparison
+  if (n <= DYNARR_SORT_INSERTION_THRESH)
+  {
+    for (size_t i = 1; i < n; i++)
+    {
+      void *item = items[i];
+      size_t j = i;
+      for (; j > 0 && dynarr_radix_strcmp(items[j - 1], item, depth, key) > 0; j--)
+        items[j] = items[j - 1];
+      items[j] = item;
+    }
+    return;
+  }
+
+  size_t counts[257] = { 0 };
+  for (size_t i = 0; i < n; i++)
+    counts[dynarr_radix_char(items[i], depth, key) + 1]++;
+
+  for (size_t c = 0; c < 256; c++)
+    counts[c + 1] += counts[c];
+
+  size_t starts[257];
+  memcpy(starts, counts, sizeof(starts));
+
+  for (size_t i = 0; i < n; i++)
+    tmp[counts[dynarr_radix_char(items[i], depth, key)]++] = items[i];
+
+  memcpy(items, tmp, sizeof(void *) * n);
+
+  // Keys in the terminator bucket are equal, recurse into all others
+  for (size_t c = 1; c < 256; c++)
+  {
+    size_t bucket = starts[c + 1] - starts[c];
+    if (bucket > 1)
+      dynarr_radix_str_rec(&items[starts[c]], tmp, bucket, depth + 1, key);
+  }
+}
+
+void dynarr_sort_radix_str(dynarr_t *arr, dynarr_radix_str_f key)
+{
+  size_t n = dynarr_pack(arr);
+  if (n < 2) return;
+
+  scptr void **tmp = (void **) mman_alloc(sizeof(void *), n, NULL);
+  dynarr_radix_str_rec(arr->items, tmp, n, 0, key);
+}
+
+/*
+============================================================================
+                                 Searching
+============================================================================
+*/
+
+dynarr_result_t dynarr_bsearch(dynarr_t *arr, const void *key, dynarr_key_cmp_f cmp, size_t *index)
+{
+  // Search the lower bound within the packed items
+  size_t n = dynarr_length(arr);
+  size_t lo = 0, hi = n;
+  while (lo < hi)
+  {
+    size_t mid = lo + (hi - lo) / 2;
+    if (cmp(key, arr->items[mid]) > 0) lo = mid + 1;
+    else hi = mid;
+  }
+
+  if (index) *index = lo;
+
+  bool found = lo < n && cmp(key, arr->items[lo]) == 0;
+  return found ? DYNARR_SUCCESS : DYNARR_INDEX_NOT_FOUND;
+}
+
+/*
+============================================================================
+                               Parallel Sort
+============================================================================
+*/
+
+/**
+ * @brief Range of items to be sorted or merged by one thread
+ */
+typedef struct
+{
+  void **items;
+  void **tmp;
+
+  // Sorting sorts [0, n), merging merges [0, mid) with [mid, n)
+  size_t mid;
+  size_t n;
+
+  dynarr_cmp_f cmp;
+} dynarr_sort_part_t;
+
+static void dynarr_sort_routine(void *arg, size_t from, size_t to)
+{
+  for (size_t i = from; i < to; i++)
+  {
+    dynarr_sort_part_t *part = &((dynarr_sort_part_t *) arg)[i];
+    dynarr_introsort(part->items, part->n, dynarr_sort_depth(part->n), part->cmp);
+  }
+}
+
+/**
+ * @brief Stable merge of a part's two halves into the scratch buffer, then copied back
+ */
+static void dynarr_merge_part(dynarr_sort_part_t *part)
+{
+  void **items = part->items, **tmp = part->tmp;
+
+  size_t i = 0, j = part->mid, k = 0;
+  while (i < part->mid && j < part->n)
+    tmp[k++] = part->cmp(items[j], items[i]) < 0 ? items[j++] : items[i++];
+
+  while (i < part->mid) tmp[k++] = items[i++];
+  while (j < part->n) tmp[k++] = items[j++];
+
+  memcpy(items, tmp, sizeof(void *) * part->n);
+}
+
+static void dynarr_merge_routine(void *arg, size_t from, size_t to)
+{
+  for (size_t i = from; i < to; i++)
+    dynarr_merge_part(&((dynarr_sort_part_t *) arg)[i]);
+}
+
+void dynarr_sort_parallel(dynarr_t *arr, dynarr_cmp_f cmp, tpool_t *pool)
+{
+  size_t n = dynarr_pack(arr);
+
+  // Constrain to threads with a worthwhile share each
+  size_t num_runs = u64_min(tpool_num_threads(pool), n / DYNARR_SORT_PARALLEL_THRESH);
+  if (num_runs < 2)
+  {
+    dynarr_introsort(arr->items, n, dynarr_sort_depth(n), cmp);
+    return;
+  }
+
+  scptr void **tmp = (void **) mman_alloc(sizeof(void *), n, NULL);
+  scptr size_t *bounds = (size_t *) mman_alloc(sizeof(size_t), num_runs + 1, NULL);
+  scptr dynarr_sort_part_t *parts = (dynarr_sort_part_t *) mman_alloc(sizeof(dynarr_sort_part_t), num_runs, NULL);
+
+  for (size_t r = 0; r <= num_runs; r++)
+    bounds[r] = n * r / num_runs;
+
+  // Sort all runs independently
+  for (size_t r = 0; r < num_runs; r++)
+  {
+    parts[r].items = &arr->items[bounds[r]];
+    parts[r].tmp = &tmp[bounds[r]];
+    parts[r].mid = 0;
+    parts[r].n = bounds[r + 1] - bounds[r];
+    parts[r].cmp = cmp;
+  }
+
+  tpool_parallel_for(pool, 0, num_runs, 1, dynarr_sort_routine, parts);
+
+  // Merge neighbouring runs pairwise, halving the number of runs per level
+  for (size_t width = 1; width < num_runs; width *= 2)
+  {
+    size_t num_merges = 0;
+    for (size_t r = 0; r + width < num_runs; r += 2 * width)
+    {
+      size_t end = bounds[u64_min(r + 2 * width, num_runs)];
+      parts[num_merges].items = &arr->items[bounds[r]];
+      parts[num_merges].tmp = &tmp[bounds[r]];
+      parts[num_merges].mid = bounds[r + width] - bounds[r];
+      parts[num_merges].n = end - bounds[r];
+      parts[num_merges].cmp = cmp;
+      num_merges++;
+    }
+
+    tpool_parallel_for(pool, 0, num_merges, 1, dynarr_merge_routine, parts);
+  }
+}
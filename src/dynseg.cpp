@@ -0,0 +1,201 @@
+#include "blvckstd/dynseg.h"
+
+/**
+ * @brief Clean up a no longer needed dynseg struct, all of it's chunks and items
+ */
+INLINED static void dynseg_cleanup(mman_meta_t *ref)
+{
+  dynseg_t *arr = (dynseg_t *) ref->ptr;
+
+  // Clean up items if applicable
+  if (arr->_cf)
+  {
+    for (size_t i = 0; i < arr->_array_size; i++)
+    {
+      void *item = dynseg_get(arr, i);
+      if (item) arr->_cf(item);
+    }
+  }
+
+  for (size_t c = 0; c < arr->_chunk_count; c++)
+    mman_dealloc(arr->chunks[c]);
+
+  mman_dealloc(arr->chunks);
+  mman_dealloc(arr->_occupied);
+}
+
+/**
+ * @brief Get the number of occupancy words needed for a number of slots
+ */
+INLINED static size_t dynseg_occupancy_words(size_t slots)
+{
+  return (slots + 63) / 64;
+}
+
+/**
+ * @brief Keep track of whether a slot is occupied
+ */
+INLINED static void dynseg_mark(dynseg_t *arr, size_t index, bool occupied)
+{
+  uint64_t bit = (uint64_t) 1 << (index % 64);
+
+  if (occupied)
+  {
+    arr->_occupied[index / 64] |= bit;
+    return;
+  }
+
+  arr->_occupied[index / 64] &= ~bit;
+  if (index < arr->_free_hint) arr->_free_hint = index;
+}
+
+/**
+ * @brief Find the lowest empty slot in use, starting at the hint and skipping 64 occupied slots at a time
+ *
+ * @param arr Array reference
+ * @param index Index output
+ * @return true An empty slot has been found
+ * @return false All slots in use are occupied
+ */
+static bool dynseg_find_free(dynseg_t *arr, size_t *index)
+{
+  size_t words = dynseg_occupancy_words(arr->_array_size);
+
+  for (size_t w = arr->_free_hint / 64; w < words; w++)
+  {
+    uint64_t free = ~arr->_occupied[w];
+
+    // Slots below the hint are known to be occupied
+    if (w == arr->_free_hint / 64)
+      free &= ~(uint64_t) 0 << (arr->_free_hint % 64);
+
+    if (!free) continue;
+
+    // Bits past the last slot in use are never set, stop there
+    size_t i = w * 64 + __builtin_ctzll(free);
+    if (i >= arr->_array_size) break;
+
+    *index = i;
+    return true;
+  }
+
+  arr->_free_hint = arr->_array_size;
+  return false;
+}
+
+dynseg_t *dynseg_make(size_t chunk_slots, size_t array_max_size, clfn_t cf)
+{
+  scptr dynseg_t *res = (dynseg_t *) mman_alloc(sizeof(dynseg_t), 1, dynseg_cleanup);
+
+  // Round up to the next power of two
+  if (chunk_slots == 0) chunk_slots = DYNSEG_DEFAULT_CHUNK_SLOTS;
+  size_t shift = 0;
+  while (((size_t) 1 << shift) < chunk_slots) shift++;
+
+  res->_chunk_shift = shift; // no freeing
+  res->_chunk_count = 0; // no freeing
+  res->_dir_size = 4; // no freeing
+  res->_array_size = 0; // no freeing
+  res->_array_cap = array_max_size; // no freeing
+  res->_item_count = 0; // no freeing
+  res->_cf = cf; // no freeing
+  res->_free_hint = 0; // no freeing
+
+  // Chunks are allocated on demand
+  res->chunks = (void ***) mman_alloc(sizeof(void **), res->_dir_size, NULL); // needs mman freeing
+  res->_occupied = NULL; // needs mman freeing, allocated along with the first chunk
+
+  return (dynseg_t *) mman_ref(res);
+}
+
+/**
+ * @brief Append a new chunk, doubling the directory if it's full
+ */
+static void dynseg_add_chunk(dynseg_t *arr)
+{
+  if (arr->_chunk_count == arr->_dir_size)
+  {
+    arr->_dir_size *= 2;
+    arr->chunks = (void ***) mman_realloc((void **) &arr->chunks, sizeof(void **), arr->_dir_size)->ptr;
+  }
+
+  // Slots are initialized as they're taken into use
+  arr->chunks[arr->_chunk_count++] = (void **) mman_alloc(sizeof(void *), (size_t) 1 << arr->_chunk_shift, NULL); // needs mman freeing
+
+  // Extend the occupancy to the new chunk's slots, which start out empty
+  size_t old_words = dynseg_occupancy_words((arr->_chunk_count - 1) << arr->_chunk_shift);
+  size_t new_words = dynseg_occupancy_words(arr->_chunk_count << arr->_chunk_shift);
+  if (new_words == old_words) return;
+
+  if (!arr->_occupied)
+    arr->_occupied = (uint64_t *) mman_alloc(sizeof(uint64_t), new_words, NULL);
+  else
+    arr->_occupied = (uint64_t *) mman_realloc((void **) &arr->_occupied, sizeof(uint64_t), new_words)->ptr;
+
+  memset(&arr->_occupied[old_words], 0, sizeof(uint64_t) * (new_words - old_words));
+}
+
+dynarr_result_t dynseg_push(dynseg_t *arr, void *item, size_t *slot)
+{
+  // Fill the lowest hole, otherwise append behind the last slot
+  size_t index;
+  if (!dynseg_find_free(arr, &index))
+  {
+    // No more free slots
+    index = arr->_array_size;
+    if (index >= arr->_array_cap) return DYNARR_FULL;
+
+    // Take the next chunk into use
+    if ((index >> arr->_chunk_shift) == arr->_chunk_count)
+      dynseg_add_chunk(arr);
+
+    arr->_array_size++;
+  }
+
+  *dynseg_slot(arr, index) = item;
+  dynseg_mark(arr, index, item != NULL);
+  if (item)
+  {
+    arr->_item_count++;
+    arr->_free_hint = index + 1;
+  }
+
+  if (slot) *slot = index;
+  return DYNARR_SUCCESS;
+}
+
+dynarr_result_t dynseg_set_at(dynseg_t *arr, size_t index, void *item)
+{
+  void **slot = dynseg_slot(arr, index);
+  if (!slot) return DYNARR_INDEX_NOT_FOUND;
+
+  // Free old entry, if any
+  if (*slot)
+  {
+    if (arr->_cf) arr->_cf(*slot);
+    arr->_item_count--;
+  }
+
+  *slot = item;
+  dynseg_mark(arr, index, item != NULL);
+  if (item) arr->_item_count++;
+  return DYNARR_SUCCESS;
+}
+
+dynarr_result_t dynseg_remove_at(dynseg_t *arr, size_t index, void **out)
+{
+  void **slot = dynseg_slot(arr, index);
+  if (!slot) return DYNARR_INDEX_NOT_FOUND;
+
+  if (out) *out = *slot;
+  if (*slot) arr->_item_count--;
+
+  *slot = NULL;
+  dynseg_mark(arr, index, false);
+  return DYNARR_SUCCESS;
+}
+
+size_t dynseg_length(dynseg_t *arr)
+{
+  return arr->_item_count;
+}
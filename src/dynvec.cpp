@@ -0,0 +1,131 @@
+#include "blvckstd/dynvec.h"
+
+/**
+ * @brief Get a pointer to the element at an index, without any range check
+ */
+INLINED static char *dynvec_slot(dynvec_t *vec, size_t index)
+{
+  return (char *) vec->items + index * vec->_elem_size;
+}
+
+/**
+ * @brief Clean up all elements within a range
+ */
+INLINED static void dynvec_cleanup_range(dynvec_t *vec, size_t from, size_t to)
+{
+  if (!vec->_cf) return;
+
+  for (size_t i = from; i < to; i++)
+    vec->_cf(dynvec_slot(vec, i));
+}
+
+/**
+ * @brief Clean up a no longer needed dynvec struct and all of it's elements
+ */
+INLINED static void dynvec_cleanup(mman_meta_t *ref)
+{
+  dynvec_t *vec = (dynvec_t *) ref->ptr;
+  dynvec_cleanup_range(vec, 0, vec->_length);
+  mman_dealloc(vec->items);
+}
+
+dynvec_t *dynvec_make(size_t elem_size, size_t array_size, size_t array_max_size, clfn_t cf)
+{
+  scptr dynvec_t *res = (dynvec_t *) mman_alloc(sizeof(dynvec_t), 1, dynvec_cleanup);
+
+  res->_elem_size = elem_size; // no freeing
+  res->_length = 0; // no freeing
+  res->_array_size = array_size; // no freeing
+  res->_array_cap = array_max_size; // no freeing
+  res->_cf = cf; // no freeing
+
+  // Elements are only valid up to the length, no need to initialize
+  res->items = mman_alloc(elem_size, array_size, NULL); // needs mman freeing
+
+  return (dynvec_t *) mman_ref(res);
+}
+
+static bool dynvec_try_resize(dynvec_t *vec)
+{
+  size_t rem_cap = vec->_array_cap - vec->_array_size;
+  if (rem_cap == 0) return false;
+
+  // Try to double the amount of elements, go straight to the cap otherwise
+  size_t new_size = vec->_array_size ? vec->_array_size * 2 : 1;
+  if (new_size > vec->_array_size + rem_cap)
+    new_size = vec->_array_size + rem_cap;
+
+  vec->items = mman_realloc(&vec->items, vec->_elem_size, new_size)->ptr;
+  vec->_array_size = new_size;
+  return true;
+}
+
+size_t dynvec_length(dynvec_t *vec)
+{
+  return vec->_length;
+}
+
+void *dynvec_at(dynvec_t *vec, size_t index)
+{
+  if (index >= vec->_length) return NULL;
+  return dynvec_slot(vec, index);
+}
+
+dynarr_result_t dynvec_push(dynvec_t *vec, const void *elem, size_t *slot)
+{
+  // No more free slots
+  if (vec->_length == vec->_array_size && !dynvec_try_resize(vec))
+    return DYNARR_FULL;
+
+  memcpy(dynvec_slot(vec, vec->_length), elem, vec->_elem_size);
+  if (slot) *slot = vec->_length;
+
+  vec->_length++;
+  return DYNARR_SUCCESS;
+}
+
+dynarr_result_t dynvec_get(dynvec_t *vec, size_t index, void *out)
+{
+  if (index >= vec->_length) return DYNARR_INDEX_NOT_FOUND;
+
+  memcpy(out, dynvec_slot(vec, index), vec->_elem_size);
+  return DYNARR_SUCCESS;
+}
+
+dynarr_result_t dynvec_set_at(dynvec_t *vec, size_t index, const void *elem)
+{
+  if (index >= vec->_length) return DYNARR_INDEX_NOT_FOUND;
+
+  // Free old element
+  char *slot = dynvec_slot(vec, index);
+  if (vec->_cf) vec->_cf(slot);
+
+  memcpy(slot, elem, vec->_elem_size);
+  return DYNARR_SUCCESS;
+}
+
+dynarr_result_t dynvec_remove_at(dynvec_t *vec, size_t index, void *out)
+{
+  if (index >= vec->_length) return DYNARR_INDEX_NOT_FOUND;
+
+  // Write element to output buffer
+  char *slot = dynvec_slot(vec, index);
+  if (out) memcpy(out, slot, vec->_elem_size);
+
+  // Close the gap
+  memmove(slot, slot + vec->_elem_size, vec->_elem_size * (vec->_length - index - 1));
+  vec->_length--;
+  return DYNARR_SUCCESS;
+}
+
+dynarr_result_t dynvec_pop(dynvec_t *vec, void *out)
+{
+  if (vec->_length == 0) return DYNARR_EMPTY;
+  return dynvec_remove_at(vec, vec->_length - 1, out);
+}
+
+void dynvec_clear(dynvec_t *vec)
+{
+  dynvec_cleanup_range(vec, 0, vec->_length);
+  vec->_length = 0;
+}
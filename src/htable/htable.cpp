@@ -0,0 +1,808 @@
+#include "blvckstd/htable.h"
+#include "blvckstd/bloom.h"
+
+#include "blvckstd/tpool.h"
+
+ENUM_LUT_FULL_IMPL(htable_result, _EVALS_HTABLE_RESULT);
+
+/**
+ * @brief Clean up an individual slot
+ */
+static void htable_slot_cleanup(htable_entry_t *slot, clfn_t cf)
+{
+  // Call the item free function, if applicable
+  if (cf && slot->value) cf(slot->value);
+
+  // Free the next chain in the linked list, if applicable
+  if (slot->_next) htable_slot_cleanup(slot->_next, cf);
+
+  // Free the slot itself, byte keys live in the same block
+  mman_dealloc(slot);
+}
+
+/**
+ * @brief Clean up a no longer needed htable struct and it's slots
+ */
+static void htable_cleanup(mman_meta_t *ref)
+{
+  htable_t *table = (htable_t *) ref->ptr;
+
+  // Free all table slots
+  for (size_t i = 0; i < table->_slot_count; i++)
+  {
+    // Skip empty slots
+    htable_entry_t *slot = table->slots[i];
+    if (!slot) continue;
+
+    htable_slot_cleanup(slot, table->_cf);
+  }
+
+  // Free the slot pointers and the filter
+  mman_dealloc(table->slots);
+  mman_dealloc(table->_bloom);
+
+  // Free the frozen state, which owns it's values
+  htable_frozen_t *frozen = table->_frozen;
+  if (!frozen) return;
+
+  for (size_t i = 0; i < frozen->_entry_count; i++)
+  {
+    void *value = frozen->entries[i].value;
+    if (table->_cf && value) table->_cf(value);
+  }
+
+  mman_dealloc(frozen->entries);
+  mman_dealloc(frozen->displacements);
+  mman_dealloc(frozen->keys);
+  mman_dealloc(frozen);
+}
+
+/**
+ * @brief Calculate the number of slots for a number of items, constrained to at least two
+ */
+INLINED static size_t htable_slots_for(size_t items)
+{
+  return u64_max((uint64_t) (items / HTABLE_ITEMS_PER_SLOT), 2);
+}
+
+htable_t *htable_make(size_t item_cap, clfn_t cf)
+{
+  scptr htable_t *table = (htable_t *) mman_alloc(sizeof(htable_t), 1, htable_cleanup);
+
+  // Calculate number of slots
+  size_t slots = htable_slots_for(item_cap);
+
+  table->_item_count = 0; // No freeing
+  table->_slot_count = slots; // No freeing
+  table->_item_cap = item_cap; // No freeing
+  table->_cf = cf; // No freeing
+  table->_int_keys = false; // No freeing
+  table->_shrink_threshold = 0; // No automatic shrinking
+  table->_frozen = NULL; // Not frozen yet
+  table->_bloom = NULL; // Not attached yet
+
+  table->_probe_stats = false; // Not counting
+  table->_lookups = 0; // No freeing
+  table->_probes = 0; // No freeing
+
+  // Allocate all slots and initialize them to nullptrs
+  table->slots = (htable_entry_t **) mman_alloc(sizeof(htable_entry_t *), table->_slot_count, NULL); // needs mman freeing
+  for (size_t i = 0; i < table->_slot_count; i++)
+    table->slots[i] = NULL;
+
+  return (htable_t *) mman_ref(table);
+}
+
+htable_t *htable_make_u64(size_t item_cap, clfn_t cf)
+{
+  htable_t *table = htable_make(item_cap, cf);
+  table->_int_keys = true;
+  return table;
+}
+
+htable_t *htable_make_unbounded(size_t initial_items, clfn_t cf)
+{
+  // Slots only grow towards the cap, so there's no limit to their growth either
+  htable_t *table = htable_make(initial_items, cf);
+  table->_item_cap = HTABLE_UNBOUNDED;
+  return table;
+}
+
+/*
+============================================================================
+                              Generic Keys
+============================================================================
+*/
+
+/**
+ * @brief Count a lookup and the entries compared during it, if enabled
+ */
+INLINED static void htable_count_probes(htable_t *table, size_t probes)
+{
+  if (!table->_probe_stats) return;
+
+  atomic_increment(&table->_lookups);
+  atomic_add(&table->_probes, probes);
+}
+
+INLINED static htable_entry_t *find_entry(htable_t *table, htable_key_t *key)
+{
+  // Tables only ever contain keys of their own type
+  if (key->is_int != table->_int_keys) return NULL;
+
+  // Most misses are ruled out by the filter
+  if (table->_bloom && !bloom_may_contain_hash(table->_bloom, key->hash))
+  {
+    htable_count_probes(table, 0);
+    return NULL;
+  }
+
+  // Frozen tables are answered by a single probe
+  if (table->_frozen)
+  {
+    htable_count_probes(table, 1);
+    return htable_frozen_find(table->_frozen, key);
+  }
+
+  htable_entry_t *slot = table->slots[key->hash % table->_slot_count];
+
+  // Traverse linked list
+  size_t probes = 0;
+  while (slot)
+  {
+    probes++;
+
+    // Search slot that contains this key
+    if (htable_entry_matches(slot, key))
+      break;
+
+    slot = slot->_next;
+  }
+
+  // Not found if the chain ended
+  htable_count_probes(table, probes);
+  return slot;
+}
+
+/**
+ * @brief Allocate a new, unlinked entry holding a copy of the key
+ */
+static htable_entry_t *htable_entry_make(htable_key_t *key, void *elem)
+{
+  // Byte keys are stored right behind the entry, which saves an allocation
+  size_t key_size = key->is_int ? 0 : key->len + 1;
+  htable_entry_t *entry = (htable_entry_t *) mman_alloc(sizeof(htable_entry_t) + key_size, 1, NULL); // needs mman freeing
+
+  if (key->is_int)
+  {
+    entry->int_key = key->int_key;
+    entry->key_len = 0;
+  }
+  else
+  {
+    entry->key = (char *) (entry + 1);
+    entry->key_len = key->len;
+    memcpy(entry->key, key->bytes, key->len);
+    entry->key[key->len] = 0;
+  }
+
+  entry->_hash = key->hash;
+  entry->value = elem;
+  entry->_next = NULL;
+  return entry;
+}
+
+htable_result_t htable_insert_key(htable_t *table, htable_key_t *key, void *elem)
+{
+  return htable_insert_entry(table, key, elem, NULL);
+}
+
+htable_result_t htable_insert_entry(htable_t *table, htable_key_t *key, void *elem, htable_entry_t **entry)
+{
+  // Frozen tables are read-only
+  if (table->_frozen) return HTABLE_FROZEN;
+
+  // Tables only ever contain keys of their own type
+  if (key->is_int != table->_int_keys) return HTABLE_KEY_TYPE_MISMATCH;
+
+  // Already containing as many items as allowed
+  if (table->_item_count >= table->_item_cap) return HTABLE_FULL;
+
+  // Tried to insert a null value
+  if (!elem) return HTABLE_NULL_VALUE;
+
+  // Grow back towards the designed slot count after having been shrunk
+  size_t max_slots = htable_slots_for(table->_item_cap);
+  if (table->_slot_count < max_slots && table->_item_count >= table->_slot_count * HTABLE_ITEMS_PER_SLOT)
+    htable_rehash(table, u64_min(table->_slot_count * 2, max_slots));
+
+  // Find the target slot and prepend the new entry
+  htable_entry_t **slot = &table->slots[key->hash % table->_slot_count];
+  htable_entry_t *created = htable_entry_make(key, elem);
+  created->_next = *slot;
+  *slot = created;
+
+  if (table->_bloom) bloom_add_hash(table->_bloom, key->hash);
+  if (entry) *entry = created;
+
+  // Increment item counter
+  atomic_increment(&table->_item_count);
+  return HTABLE_SUCCESS;
+}
+
+htable_result_t htable_remove_key(htable_t *table, htable_key_t *key)
+{
+  // Frozen tables are read-only
+  if (table->_frozen) return HTABLE_FROZEN;
+
+  // Tables only ever contain keys of their own type
+  if (key->is_int != table->_int_keys) return HTABLE_KEY_TYPE_MISMATCH;
+
+  // Traverse linked list, keep the link pointing at the current entry
+  htable_entry_t **link = &table->slots[key->hash % table->_slot_count];
+  while (*link)
+  {
+    htable_entry_t *slot = *link;
+
+    // Search slot that contains this key
+    if (htable_entry_matches(slot, key))
+    {
+      // Unlink, works for the head as well as any other entry
+      *link = slot->_next;
+
+      // Deallocate and decrement item counter
+      if (table->_cf) table->_cf(slot->value);
+      mman_dealloc(slot);
+      atomic_decrement(&table->_item_count);
+
+      // Shrink once the load dropped below the threshold
+      double min_items = table->_shrink_threshold * table->_slot_count * HTABLE_ITEMS_PER_SLOT;
+      if (table->_slot_count > 2 && table->_item_count < min_items)
+        htable_shrink_to_fit(table);
+
+      return HTABLE_SUCCESS;
+    }
+
+    link = &slot->_next;
+  }
+
+  // Not found
+  return HTABLE_KEY_NOT_FOUND;
+}
+
+htable_entry_t *htable_find_entry(htable_t *table, htable_key_t *key)
+{
+  return find_entry(table, key);
+}
+
+htable_result_t htable_fetch_key(htable_t *table, htable_key_t *key, void **output)
+{
+  htable_entry_t *entry = find_entry(table, key);
+
+  if (entry)
+  {
+    *output = entry->value;
+    return HTABLE_SUCCESS;
+  }
+
+  *output = NULL;
+  return key->is_int != table->_int_keys ? HTABLE_KEY_TYPE_MISMATCH : HTABLE_KEY_NOT_FOUND;
+}
+
+/*
+============================================================================
+                                  Resizing
+============================================================================
+*/
+
+htable_result_t htable_rehash(htable_t *table, size_t slot_count)
+{
+  // Frozen tables are read-only
+  if (table->_frozen) return HTABLE_FROZEN;
+
+  slot_count = u64_max(slot_count, 1);
+  if (slot_count == table->_slot_count) return HTABLE_SUCCESS;
+
+  htable_entry_t **slots = (htable_entry_t **) mman_calloc(sizeof(htable_entry_t *), slot_count, NULL); // needs mman freeing
+  if (!slots) return HTABLE_FULL;
+
+  // Relink all entries, their stored hashes spare rehashing the keys
+  for (size_t i = 0; i < table->_slot_count; i++)
+  {
+    htable_entry_t *entry = table->slots[i];
+    while (entry)
+    {
+      htable_entry_t *next = entry->_next;
+      htable_entry_t **slot = &slots[entry->_hash % slot_count];
+      entry->_next = *slot;
+      *slot = entry;
+      entry = next;
+    }
+  }
+
+  mman_dealloc(table->slots);
+  table->slots = slots;
+  table->_slot_count = slot_count;
+  return HTABLE_SUCCESS;
+}
+
+htable_result_t htable_shrink_to_fit(htable_t *table)
+{
+  // Leave room for as many items again, never growing past the current or designed slot count
+  size_t slots = u64_min(htable_slots_for(table->_item_count) * 2, htable_slots_for(table->_item_cap));
+  return htable_rehash(table, u64_min(slots, table->_slot_count));
+}
+
+void htable_set_shrink_threshold(htable_t *table, double threshold)
+{
+  // Higher thresholds would shrink right back to the load that makes insertions grow again
+  if (threshold < 0) threshold = 0;
+  if (threshold > HTABLE_MAX_SHRINK_THRESHOLD) threshold = HTABLE_MAX_SHRINK_THRESHOLD;
+  table->_shrink_threshold = threshold;
+}
+
+/*
+============================================================================
+                                Bloom Filter
+============================================================================
+*/
+
+void htable_attach_bloom(htable_t *table, size_t bits_per_item)
+{
+  htable_detach_bloom(table);
+  // Unbounded tables can't be sized for their cap
+  size_t items = table->_item_cap;
+  if (items == HTABLE_UNBOUNDED) items = table->_slot_count * HTABLE_ITEMS_PER_SLOT;
+
+  bloom_t *bloom = bloom_make(items, bits_per_item); // needs mman freeing
+
+  // Fill with the stored hashes of all current entries
+  scptr htable_entry_t **entries = NULL;
+  size_t num_entries = htable_list_entries(table, &entries);
+  for (size_t i = 0; i < num_entries; i++)
+    bloom_add_hash(bloom, entries[i]->_hash);
+
+  table->_bloom = bloom;
+}
+
+void htable_detach_bloom(htable_t *table)
+{
+  mman_dealloc(table->_bloom);
+  table->_bloom = NULL;
+}
+
+/*
+============================================================================
+                                String Keys
+============================================================================
+*/
+
+htable_result_t htable_insert(htable_t *table, const char *key, void *elem)
+{
+  // Strings are limited to a max-length
+  htable_key_t k = htable_key_str(key);
+  if (k.len > HTABLE_MAX_KEYLEN) return HTABLE_KEY_TOO_LONG;
+
+  return htable_insert_key(table, &k, elem);
+}
+
+bool htable_contains(htable_t *table, const char *key)
+{
+  htable_key_t k = htable_key_str(key);
+  return find_entry(table, &k) != NULL;
+}
+
+htable_result_t htable_remove(htable_t *table, const char *key)
+{
+  htable_key_t k = htable_key_str(key);
+  return htable_remove_key(table, &k);
+}
+
+htable_result_t htable_fetch(htable_t *table, const char *key, void **output)
+{
+  htable_key_t k = htable_key_str(key);
+  return htable_fetch_key(table, &k, output);
+}
+
+/*
+============================================================================
+                          Integer and Binary Keys
+============================================================================
+*/
+
+htable_result_t htable_insert_u64(htable_t *table, uint64_t key, void *elem)
+{
+  htable_key_t k = htable_key_u64(key);
+  return htable_insert_key(table, &k, elem);
+}
+
+bool htable_contains_u64(htable_t *table, uint64_t key)
+{
+  htable_key_t k = htable_key_u64(key);
+  return find_entry(table, &k) != NULL;
+}
+
+htable_result_t htable_remove_u64(htable_t *table, uint64_t key)
+{
+  htable_key_t k = htable_key_u64(key);
+  return htable_remove_key(table, &k);
+}
+
+htable_result_t htable_fetch_u64(htable_t *table, uint64_t key, void **output)
+{
+  htable_key_t k = htable_key_u64(key);
+  return htable_fetch_key(table, &k, output);
+}
+
+htable_result_t htable_insert_bin(htable_t *table, const void *key, size_t key_len, void *elem)
+{
+  htable_key_t k = htable_key_bin(key, key_len);
+  return htable_insert_key(table, &k, elem);
+}
+
+bool htable_contains_bin(htable_t *table, const void *key, size_t key_len)
+{
+  htable_key_t k = htable_key_bin(key, key_len);
+  return find_entry(table, &k) != NULL;
+}
+
+htable_result_t htable_remove_bin(htable_t *table, const void *key, size_t key_len)
+{
+  htable_key_t k = htable_key_bin(key, key_len);
+  return htable_remove_key(table, &k);
+}
+
+htable_result_t htable_fetch_bin(htable_t *table, const void *key, size_t key_len, void **output)
+{
+  htable_key_t k = htable_key_bin(key, key_len);
+  return htable_fetch_key(table, &k, output);
+}
+
+/*
+============================================================================
+                                  Listing
+============================================================================
+*/
+
+size_t htable_list_entries(htable_t *table, htable_entry_t ***output)
+{
+  *output = (htable_entry_t **) mman_alloc(sizeof(htable_entry_t *), table->_item_count + 1, NULL);
+  size_t output_index = 0;
+
+  // Frozen tables keep all entries contiguously
+  if (table->_frozen)
+  {
+    for (size_t i = 0; i < table->_frozen->_entry_count; i++)
+      (*output)[output_index++] = &table->_frozen->entries[i];
+  }
+
+  for (size_t i = 0; i < table->_slot_count; i++)
+  {
+    // Traverse linked list, skip empty slots
+    for (htable_entry_t *slot = table->slots[i]; slot; slot = slot->_next)
+      (*output)[output_index++] = slot;
+  }
+
+  // Terminate list
+  (*output)[output_index] = NULL;
+  return output_index;
+}
+
+htable_result_t htable_append_table(htable_t *dest, htable_t *src, htable_append_mode_t mode, htable_value_clone_f cf)
+{
+  // Keys can't be converted between types
+  if (dest->_int_keys != src->_int_keys) return HTABLE_KEY_TYPE_MISMATCH;
+
+  // Get all entries from the source
+  scptr htable_entry_t **entries = NULL;
+  size_t num_entries = htable_list_entries(src, &entries);
+
+  // Check if there are any collisions beforehand
+  if (mode == HTABLE_AM_DUPERR)
+  {
+    // Iterate all available entries
+    for (size_t i = 0; i < num_entries; i++)
+    {
+      htable_key_t key = htable_entry_key(entries[i], src->_int_keys);
+      if (find_entry(dest, &key))
+        return HTABLE_KEY_ALREADY_EXISTS;
+    }
+  }
+
+  // Iterate all available entries
+  for (size_t i = 0; i < num_entries; i++)
+  {
+    htable_key_t key = htable_entry_key(entries[i], src->_int_keys);
+
+    // Decide what mode to execute on this key
+    htable_result_t insertion_result;
+
+    if (mode == HTABLE_AM_OVERRIDE)
+    {
+      // Remove key if exists (don't even check errors, faster)
+      htable_remove_key(dest, &key);
+    }
+
+    if (mode == HTABLE_AM_SKIP)
+    {
+      // Skip duplicate
+      if (find_entry(dest, &key)) continue;
+    }
+
+    // Insert new value
+    if ((insertion_result = htable_insert_key(dest, &key, cf(entries[i]->value))) != HTABLE_SUCCESS)
+      return insertion_result;
+  }
+
+  return HTABLE_SUCCESS;
+}
+
+/**
+ * @brief Share of a parallel append, owning all destination slots with
+ * an index congruent to it's own index modulo the number of parts
+ */
+typedef struct
+{
+  htable_t *dest;
+
+  // Source entries falling into this part's slots
+  htable_entry_t **entries;
+  size_t num_entries;
+
+  htable_append_mode_t mode;
+  htable_value_clone_f cf;
+  bool int_keys;
+
+  // First error this part ran into
+  htable_result_t result;
+} htable_append_part_t;
+
+/**
+ * @brief Check a part's entries for keys already existing in the destination
+ */
+static void htable_append_part_check(htable_append_part_t *part)
+{
+  for (size_t i = 0; i < part->num_entries; i++)
+  {
+    htable_key_t key = htable_entry_key(part->entries[i], part->int_keys);
+    if (!find_entry(part->dest, &key)) continue;
+
+    part->result = HTABLE_KEY_ALREADY_EXISTS;
+    break;
+  }
+}
+
+static void htable_append_check_routine(void *arg, size_t from, size_t to)
+{
+  for (size_t i = from; i < to; i++)
+    htable_append_part_check(&((htable_append_part_t *) arg)[i]);
+}
+
+/**
+ * @brief Merge a part's entries into it's own destination slots
+ */
+static void htable_append_part_merge(htable_append_part_t *part)
+{
+  htable_t *dest = part->dest;
+
+  for (size_t i = 0; i < part->num_entries; i++)
+  {
+    htable_key_t key = htable_entry_key(part->entries[i], part->int_keys);
+    htable_entry_t **slot = &dest->slots[key.hash % dest->_slot_count];
+
+    // Only this part ever touches this slot, no locking needed
+    htable_entry_t *existing = *slot;
+    while (existing && !htable_entry_matches(existing, &key))
+      existing = existing->_next;
+
+    if (existing && part->mode != HTABLE_AM_OVERRIDE) continue;
+
+    // Reserve room for the new item, the counter is shared with all other parts
+    if (!existing && atomic_increment(&dest->_item_count) > dest->_item_cap)
+    {
+      atomic_decrement(&dest->_item_count);
+      part->result = HTABLE_FULL;
+      break;
+    }
+
+    void *value = part->cf(part->entries[i]->value);
+    if (!value)
+    {
+      if (!existing) atomic_decrement(&dest->_item_count);
+      part->result = HTABLE_NULL_VALUE;
+      break;
+    }
+
+    // Override in place
+    if (existing)
+    {
+      if (dest->_cf) dest->_cf(existing->value);
+      existing->value = value;
+      continue;
+    }
+
+    htable_entry_t *entry = htable_entry_make(&key, value);
+    entry->_next = *slot;
+    *slot = entry;
+  }
+}
+
+static void htable_append_merge_routine(void *arg, size_t from, size_t to)
+{
+  for (size_t i = from; i < to; i++)
+    htable_append_part_merge(&((htable_append_part_t *) arg)[i]);
+}
+
+/**
+ * @brief Get the first error any of the parts ran into
+ */
+INLINED static htable_result_t htable_append_parts_result(htable_append_part_t *parts, size_t num_parts)
+{
+  for (size_t i = 0; i < num_parts; i++)
+    if (parts[i].result != HTABLE_SUCCESS) return parts[i].result;
+  return HTABLE_SUCCESS;
+}
+
+htable_result_t htable_append_table_parallel(htable_t *dest, htable_t *src, htable_append_mode_t mode, htable_value_clone_f cf, tpool_t *pool)
+{
+  // Frozen tables are read-only
+  if (dest->_frozen) return HTABLE_FROZEN;
+
+  // Keys can't be converted between types
+  if (dest->_int_keys != src->_int_keys) return HTABLE_KEY_TYPE_MISMATCH;
+
+  // Slots can't be resized while the parts own them, so grow up front
+  size_t max_slots = htable_slots_for(dest->_item_cap);
+  if (dest->_slot_count < max_slots) htable_rehash(dest, max_slots);
+
+  // Get all entries from the source
+  scptr htable_entry_t **entries = NULL;
+  size_t num_entries = htable_list_entries(src, &entries);
+  if (num_entries == 0) return HTABLE_SUCCESS;
+
+  // Multiple parts per thread, so that the pool can balance uneven parts
+  size_t num_parts = u64_max(u64_min(tpool_num_threads(pool) * TPOOL_CHUNKS_PER_THREAD, dest->_slot_count), 1);
+
+  // Counting sort the entries by the part owning their destination slot
+  scptr size_t *offsets = (size_t *) mman_calloc(sizeof(size_t), num_parts + 1, NULL);
+  for (size_t i = 0; i < num_entries; i++)
+    offsets[(entries[i]->_hash % dest->_slot_count) % num_parts + 1]++;
+
+  for (size_t i = 0; i < num_parts; i++)
+    offsets[i + 1] += offsets[i];
+
+  scptr size_t *cursors = (size_t *) mman_alloc(sizeof(size_t), num_parts, NULL);
+  memcpy(cursors, offsets, sizeof(size_t) * num_parts);
+
+  scptr htable_entry_t **sorted = (htable_entry_t **) mman_alloc(sizeof(htable_entry_t *), num_entries, NULL);
+  for (size_t i = 0; i < num_entries; i++)
+    sorted[cursors[(entries[i]->_hash % dest->_slot_count) % num_parts]++] = entries[i];
+
+  scptr htable_append_part_t *parts = (htable_append_part_t *) mman_alloc(sizeof(htable_append_part_t), num_parts, NULL);
+  for (size_t i = 0; i < num_parts; i++)
+  {
+    parts[i].dest = dest;
+    parts[i].entries = &sorted[offsets[i]];
+    parts[i].num_entries = offsets[i + 1] - offsets[i];
+    parts[i].mode = mode;
+    parts[i].cf = cf;
+    parts[i].int_keys = src->_int_keys;
+    parts[i].result = HTABLE_SUCCESS;
+  }
+
+  // Check if there are any collisions beforehand, without modifying the destination
+  if (mode == HTABLE_AM_DUPERR)
+  {
+    tpool_parallel_for(pool, 0, num_parts, 1, htable_append_check_routine, parts);
+
+    htable_result_t check_result = htable_append_parts_result(parts, num_parts);
+    if (check_result != HTABLE_SUCCESS) return check_result;
+  }
+
+  tpool_parallel_for(pool, 0, num_parts, 1, htable_append_merge_routine, parts);
+
+  // The parts share filter blocks, so the filter is filled afterwards, where
+  // adding skipped or failed keys only ever causes false positives
+  if (dest->_bloom)
+  {
+    for (size_t i = 0; i < num_entries; i++)
+      bloom_add_hash(dest->_bloom, entries[i]->_hash);
+  }
+
+  return htable_append_parts_result(parts, num_parts);
+}
+
+size_t htable_list_keys(htable_t *table, char ***output)
+{
+  *output = (char **) mman_alloc(sizeof(char *), table->_item_count + 1, NULL);
+
+  // Integer keyed tables have no string keys to list
+  size_t output_index = 0;
+  if (!table->_int_keys)
+  {
+    scptr htable_entry_t **entries = NULL;
+    size_t num_entries = htable_list_entries(table, &entries);
+
+    for (size_t i = 0; i < num_entries; i++)
+      (*output)[output_index++] = entries[i]->key;
+  }
+
+  // Terminate list
+  (*output)[output_index] = 0;
+  return output_index;
+}
+
+size_t htable_list_keys_u64(htable_t *table, uint64_t **output)
+{
+  *output = (uint64_t *) mman_alloc(sizeof(uint64_t), table->_item_count + 1, NULL);
+
+  // Only integer keyed tables have integer keys to list
+  size_t output_index = 0;
+  if (table->_int_keys)
+  {
+    scptr htable_entry_t **entries = NULL;
+    size_t num_entries = htable_list_entries(table, &entries);
+
+    for (size_t i = 0; i < num_entries; i++)
+      (*output)[output_index++] = entries[i]->int_key;
+  }
+
+  return output_index;
+}
+
+/**
+ * @brief Append a single entry to a human readable dump
+ */
+static bool htable_dump_entry(htable_t *table, htable_entry_t *entry, stringifier_t stringifier, char **buf, size_t *buf_offs)
+{
+  // Stringify value, if applicable
+  scptr char *stringified = stringifier ? stringifier(entry->value) : (char *) entry->value;
+
+  if (table->_int_keys)
+    return strfmt(buf, buf_offs, "(k=%" PRIu64 ", v=\"%s\")\n", entry->int_key, stringified);
+
+  return strfmt(buf, buf_offs, "(k=\"%s\", v=\"%s\")\n", entry->key, stringified);
+}
+
+char *htable_dump_hr(htable_t *table, stringifier_t stringifier)
+{
+  // Create a buffer for all the lines
+  size_t buf_offs = 0;
+  scptr char *buf = (char *) mman_alloc(sizeof(char), 8, NULL);
+
+  // Frozen tables have exactly one entry per index
+  if (table->_frozen)
+  {
+    for (size_t i = 0; i < table->_frozen->_entry_count; i++)
+    {
+      if (!strfmt(&buf, &buf_offs, "[%lu] ", i)) return NULL;
+      if (!htable_dump_entry(table, &table->_frozen->entries[i], stringifier, &buf, &buf_offs)) return NULL;
+    }
+  }
+
+  // Iterate all slots
+  for (size_t slot = 0; slot < table->_slot_count; slot++)
+  {
+    htable_entry_t *curr = table->slots[slot];
+
+    // Append slot position
+    if (!strfmt(&buf, &buf_offs, "[%lu] ", slot)) return NULL;
+
+    // Print linked list contents
+    while (curr)
+    {
+      if (!strfmt(&buf, &buf_offs, "\t=> ")) return NULL;
+      if (!htable_dump_entry(table, curr, stringifier, &buf, &buf_offs)) return NULL;
+
+      // Go to next link
+      curr = curr->_next;
+    }
+
+    // Print trailing "NULL _next"
+    if (!strfmt(&buf, &buf_offs, "\t=> NULL\n")) return NULL;
+  }
+
+  // Terminate whole string
+  buf[++buf_offs] = 0;
+  return (char *) mman_ref(buf);
+}
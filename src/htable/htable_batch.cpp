@@ -0,0 +1,132 @@
+#include "blvckstd/htable.h"
+#include "blvckstd/bloom.h"
+
+/*
+============================================================================
+                              Batched Lookups
+============================================================================
+*/
+
+/**
+ * @brief Resolve up to HTABLE_BATCH_SIZE keys on a mutable table in three passes
+ *
+ * @param table Table reference
+ * @param keys Keys to look up
+ * @param n Number of keys, at most HTABLE_BATCH_SIZE
+ * @param out Found values output, NULL for missing keys
+ */
+static void htable_fetch_batch(htable_t *table, const char **keys, size_t n, void **out)
+{
+  htable_key_t ks[HTABLE_BATCH_SIZE];
+  htable_entry_t **slots[HTABLE_BATCH_SIZE];
+  htable_entry_t *heads[HTABLE_BATCH_SIZE];
+
+  // Hash all keys and prefetch the slots of those the filter doesn't rule out
+  for (size_t i = 0; i < n; i++)
+  {
+    ks[i] = htable_key_str(keys[i]);
+    slots[i] = NULL;
+
+    if (table->_bloom && !bloom_may_contain_hash(table->_bloom, ks[i].hash))
+      continue;
+
+    slots[i] = &table->slots[ks[i].hash % table->_slot_count];
+    __builtin_prefetch(slots[i]);
+  }
+
+  // Load the chain heads and prefetch them
+  for (size_t i = 0; i < n; i++)
+  {
+    heads[i] = slots[i] ? *slots[i] : NULL;
+    if (heads[i]) __builtin_prefetch(heads[i]);
+  }
+
+  // Walk the now warm chains
+  for (size_t i = 0; i < n; i++)
+  {
+    out[i] = NULL;
+    for (htable_entry_t *entry = heads[i]; entry; entry = entry->_next)
+    {
+      if (!htable_entry_matches(entry, &ks[i]))
+        continue;
+
+      out[i] = entry->value;
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Resolve up to HTABLE_BATCH_SIZE keys on a frozen table in two passes
+ *
+ * @param frozen Frozen state of a table
+ * @param keys Keys to look up
+ * @param n Number of keys, at most HTABLE_BATCH_SIZE
+ * @param out Found values output, NULL for missing keys
+ */
+static void htable_frozen_fetch_batch(htable_frozen_t *frozen, const char **keys, size_t n, void **out)
+{
+  htable_key_t ks[HTABLE_BATCH_SIZE];
+  htable_entry_t *candidates[HTABLE_BATCH_SIZE];
+
+  // Hash all keys and prefetch their only candidate
+  for (size_t i = 0; i < n; i++)
+  {
+    ks[i] = htable_key_str(keys[i]);
+    candidates[i] = htable_frozen_probe(frozen, ks[i].hash);
+    if (candidates[i]) __builtin_prefetch(candidates[i]);
+  }
+
+  // Compare against the now warm candidates
+  for (size_t i = 0; i < n; i++)
+  {
+    htable_entry_t *entry = candidates[i];
+    out[i] = entry && htable_entry_matches(entry, &ks[i]) ? entry->value : NULL;
+  }
+}
+
+size_t htable_fetch_many(htable_t *table, const char **keys, size_t n, void **out)
+{
+  // Integer keyed tables don't contain any string keys
+  if (table->_int_keys)
+  {
+    for (size_t i = 0; i < n; i++)
+      out[i] = NULL;
+    return 0;
+  }
+
+  // Resolve in fixed-size batches to keep the intermediate state on the stack
+  for (size_t offs = 0; offs < n; offs += HTABLE_BATCH_SIZE)
+  {
+    size_t batch = u64_min(HTABLE_BATCH_SIZE, n - offs);
+
+    if (table->_frozen)
+      htable_frozen_fetch_batch(table->_frozen, &keys[offs], batch, &out[offs]);
+    else
+      htable_fetch_batch(table, &keys[offs], batch, &out[offs]);
+  }
+
+  // Values can never be NULL, so NULL marks a missing key
+  size_t found = 0;
+  for (size_t i = 0; i < n; i++)
+    if (out[i]) found++;
+
+  return found;
+}
+
+size_t htable_contains_many(htable_t *table, const char **keys, size_t n, bool *out)
+{
+  void *values[HTABLE_BATCH_SIZE];
+
+  size_t found = 0;
+  for (size_t offs = 0; offs < n; offs += HTABLE_BATCH_SIZE)
+  {
+    size_t batch = u64_min(HTABLE_BATCH_SIZE, n - offs);
+    found += htable_fetch_many(table, &keys[offs], batch, values);
+
+    for (size_t i = 0; i < batch; i++)
+      out[offs + i] = values[i] != NULL;
+  }
+
+  return found;
+}
@@ -0,0 +1,299 @@
+#include "blvckstd/htable.h"
+
+/*
+============================================================================
+                                  Freezing
+============================================================================
+*/
+
+// Average number of keys per displacement bucket
+#define HTABLE_FROZEN_KEYS_PER_BUCKET 2
+
+// Number of d0 values tried per bucket before choosing another seed
+#define HTABLE_FROZEN_MAX_D0 1024
+
+// Number of seeds tried before giving up
+#define HTABLE_FROZEN_MAX_SEEDS 8
+
+/**
+ * @brief Hashes derived from a key's full hash for a given seed
+ */
+typedef struct htable_frozen_hashes
+{
+  size_t bucket;    // Bucket the key belongs to
+  size_t h1;        // Base position
+  size_t h2;        // Step per d0
+} htable_frozen_hashes_t;
+
+INLINED static htable_frozen_hashes_t htable_frozen_derive(
+  uint64_t hash,
+  uint64_t seed,
+  size_t bucket_count,
+  size_t entry_count
+)
+{
+  uint64_t m1 = htable_hash_u64(hash ^ seed);
+  uint64_t m2 = htable_hash_u64(m1 ^ HTABLE_FNV_PRIME);
+
+  return (htable_frozen_hashes_t) {
+    .bucket = m1 % bucket_count,
+    .h1 = (m2 & 0xFFFFFFFF) % entry_count,
+    .h2 = (m2 >> 32) % entry_count
+  };
+}
+
+/**
+ * @brief Calculate the entry index a key lands on for a given displacement
+ */
+INLINED static size_t htable_frozen_index(htable_frozen_hashes_t *hs, uint64_t displacement, size_t entry_count)
+{
+  uint64_t d0 = displacement >> 32, d1 = displacement & 0xFFFFFFFF;
+  return (hs->h1 + d0 * hs->h2 + d1) % entry_count;
+}
+
+htable_entry_t *htable_frozen_probe(htable_frozen_t *frozen, uint64_t hash)
+{
+  // Empty tables contain nothing
+  if (frozen->_entry_count == 0) return NULL;
+
+  htable_frozen_hashes_t hs = htable_frozen_derive(hash, frozen->_seed, frozen->_bucket_count, frozen->_entry_count);
+  size_t index = htable_frozen_index(&hs, frozen->displacements[hs.bucket], frozen->_entry_count);
+  return &frozen->entries[index];
+}
+
+htable_entry_t *htable_frozen_find(htable_frozen_t *frozen, htable_key_t *key)
+{
+  // There's exactly one candidate to compare against
+  htable_entry_t *entry = htable_frozen_probe(frozen, key->hash);
+  if (!entry || !htable_entry_matches(entry, key))
+    return NULL;
+
+  return entry;
+}
+
+/**
+ * @brief Try to find a displacement for every bucket by using a given seed
+ *
+ * @param frozen Frozen state to fill the displacements of
+ * @param hashes Full hashes of all keys
+ * @param placement Output buffer, entry index for each key
+ *
+ * @return true All keys have been placed
+ * @return false At least one bucket couldn't be placed
+ */
+static bool htable_frozen_place(htable_frozen_t *frozen, uint64_t *hashes, size_t *placement)
+{
+  size_t n = frozen->_entry_count, r = frozen->_bucket_count;
+
+  // Derive all hashes and count the bucket sizes
+  scptr htable_frozen_hashes_t *derived = (htable_frozen_hashes_t *) mman_alloc(sizeof(htable_frozen_hashes_t), n, NULL);
+  scptr size_t *sizes = (size_t *) mman_calloc(sizeof(size_t), r + 1, NULL);
+  for (size_t i = 0; i < n; i++)
+  {
+    derived[i] = htable_frozen_derive(hashes[i], frozen->_seed, r, n);
+    sizes[derived[i].bucket + 1]++;
+  }
+
+  // Group keys by their bucket
+  scptr size_t *starts = (size_t *) mman_calloc(sizeof(size_t), r + 1, NULL);
+  for (size_t b = 0; b < r; b++)
+    starts[b + 1] = starts[b] + sizes[b + 1];
+
+  scptr size_t *members = (size_t *) mman_alloc(sizeof(size_t), u64_max(n, 1), NULL);
+  scptr size_t *fill = (size_t *) mman_calloc(sizeof(size_t), r, NULL);
+  for (size_t i = 0; i < n; i++)
+  {
+    size_t b = derived[i].bucket;
+    members[starts[b] + fill[b]++] = i;
+  }
+
+  // Place big buckets first, while there's still a lot of free room
+  // Bucket sizes are small, so they're counting-sorted in descending order
+  size_t max_size = 0;
+  for (size_t b = 0; b < r; b++)
+    max_size = u64_max(max_size, sizes[b + 1]);
+
+  scptr size_t *size_offs = (size_t *) mman_calloc(sizeof(size_t), max_size + 2, NULL);
+  for (size_t b = 0; b < r; b++)
+    size_offs[max_size - sizes[b + 1] + 1]++;
+  for (size_t s = 0; s <= max_size; s++)
+    size_offs[s + 1] += size_offs[s];
+
+  scptr size_t *order = (size_t *) mman_alloc(sizeof(size_t), r, NULL);
+  for (size_t b = 0; b < r; b++)
+    order[size_offs[max_size - sizes[b + 1]]++] = b;
+
+  scptr bool *taken = (bool *) mman_calloc(sizeof(bool), n, NULL);
+  scptr size_t *candidates = (size_t *) mman_alloc(sizeof(size_t), u64_max(n, 1), NULL);
+  size_t next_free = 0;
+
+  for (size_t o = 0; o < r; o++)
+  {
+    size_t b = order[o];
+    size_t size = sizes[b + 1];
+    size_t *bucket = &members[starts[b]];
+
+    frozen->displacements[b] = 0;
+    if (size == 0) continue;
+
+    // Single keys can be placed on the next free index directly
+    if (size == 1)
+    {
+      while (taken[next_free]) next_free++;
+      size_t d1 = (next_free + n - derived[bucket[0]].h1) % n;
+      frozen->displacements[b] = d1;
+      taken[next_free] = true;
+      placement[bucket[0]] = next_free;
+      continue;
+    }
+
+    // Search for a displacement which puts all keys onto free indices
+    bool placed = false;
+    for (uint64_t d0 = 0; d0 < HTABLE_FROZEN_MAX_D0 && !placed; d0++)
+    {
+      for (uint64_t d1 = 0; d1 < n && !placed; d1++)
+      {
+        uint64_t displacement = (d0 << 32) | d1;
+
+        size_t k;
+        for (k = 0; k < size; k++)
+        {
+          size_t index = htable_frozen_index(&derived[bucket[k]], displacement, n);
+          if (taken[index]) break;
+
+          // Also has to differ from all previous keys of this bucket
+          taken[index] = true;
+          candidates[k] = index;
+        }
+
+        // Collided, undo the tentative marks
+        if (k < size)
+        {
+          for (size_t u = 0; u < k; u++)
+            taken[candidates[u]] = false;
+          continue;
+        }
+
+        frozen->displacements[b] = displacement;
+        for (k = 0; k < size; k++)
+          placement[bucket[k]] = candidates[k];
+        placed = true;
+      }
+    }
+
+    if (!placed) return false;
+  }
+
+  return true;
+}
+
+static int htable_frozen_cmp_hash(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Check whether any two keys share the same full hash, by sorting a copy of the hashes
+ */
+static bool htable_frozen_has_duplicates(uint64_t *hashes, size_t n)
+{
+  scptr uint64_t *sorted = (uint64_t *) mman_alloc(sizeof(uint64_t), u64_max(n, 1), NULL);
+  memcpy(sorted, hashes, sizeof(uint64_t) * n);
+  qsort(sorted, n, sizeof(uint64_t), htable_frozen_cmp_hash);
+
+  for (size_t i = 1; i < n; i++)
+  {
+    if (sorted[i] == sorted[i - 1])
+      return true;
+  }
+
+  return false;
+}
+
+htable_result_t htable_freeze(htable_t *table)
+{
+  // Freezing twice is a no-op
+  if (table->_frozen) return HTABLE_SUCCESS;
+
+  // Collect all chained entries
+  size_t n = table->_item_count;
+  scptr htable_entry_t **chained = (htable_entry_t **) mman_alloc(sizeof(htable_entry_t *), u64_max(n, 1), NULL);
+  size_t num_chained = 0;
+  for (size_t i = 0; i < table->_slot_count; i++)
+  {
+    for (htable_entry_t *entry = table->slots[i]; entry; entry = entry->_next)
+      chained[num_chained++] = entry;
+  }
+
+  // Entries keep their hashes, there's no need to rehash any keys
+  scptr uint64_t *hashes = (uint64_t *) mman_alloc(sizeof(uint64_t), u64_max(n, 1), NULL);
+  for (size_t i = 0; i < n; i++)
+    hashes[i] = chained[i]->_hash;
+
+  // Keys sharing a full hash can never be separated, no matter the seed
+  if (htable_frozen_has_duplicates(hashes, n))
+    return HTABLE_NO_PERFECT_HASH;
+
+  scptr htable_frozen_t *frozen = (htable_frozen_t *) mman_alloc(sizeof(htable_frozen_t), 1, NULL);
+  frozen->_entry_count = n;
+  frozen->_bucket_count = u64_max(n / HTABLE_FROZEN_KEYS_PER_BUCKET, 1);
+  frozen->entries = (htable_entry_t *) mman_alloc(sizeof(htable_entry_t), u64_max(n, 1), NULL);
+  frozen->displacements = (uint64_t *) mman_alloc(sizeof(uint64_t), frozen->_bucket_count, NULL);
+
+  // All byte keys go into one contiguous arena
+  size_t keys_len = 0;
+  if (!table->_int_keys)
+  {
+    for (size_t i = 0; i < n; i++)
+      keys_len += chained[i]->key_len + 1;
+  }
+  frozen->keys = (char *) mman_alloc(sizeof(char), u64_max(keys_len, 1), NULL);
+
+  // Try multiple seeds until every key found it's own index
+  scptr size_t *placement = (size_t *) mman_alloc(sizeof(size_t), u64_max(n, 1), NULL);
+  bool placed = false;
+  for (uint64_t s = 0; s < HTABLE_FROZEN_MAX_SEEDS && !placed; s++)
+  {
+    frozen->_seed = htable_hash_u64(HTABLE_FNV_OFFSET + s);
+    placed = htable_frozen_place(frozen, hashes, placement);
+  }
+
+  if (!placed)
+  {
+    mman_dealloc(frozen->entries);
+    mman_dealloc(frozen->displacements);
+    mman_dealloc(frozen->keys);
+    return HTABLE_NO_PERFECT_HASH;
+  }
+
+  // Move all entries over, the values change ownership
+  size_t keys_offs = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    htable_entry_t *entry = &frozen->entries[placement[i]];
+    *entry = *chained[i];
+    entry->_next = NULL;
+
+    if (table->_int_keys) continue;
+
+    memcpy(&frozen->keys[keys_offs], chained[i]->key, entry->key_len + 1);
+    entry->key = &frozen->keys[keys_offs];
+    keys_offs += entry->key_len + 1;
+  }
+
+  // Free all chains without touching the values, which are now owned by the frozen state
+  for (size_t i = 0; i < n; i++)
+    mman_dealloc(chained[i]);
+
+  mman_dealloc(table->slots);
+  table->slots = NULL;
+  table->_slot_count = 0;
+  table->_frozen = (htable_frozen_t *) mman_ref(frozen);
+  return HTABLE_SUCCESS;
+}
+
+bool htable_is_frozen(htable_t *table)
+{
+  return table->_frozen != NULL;
+}
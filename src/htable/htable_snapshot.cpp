@@ -0,0 +1,219 @@
+#include "blvckstd/htable.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+============================================================================
+                                 Snapshots
+============================================================================
+*/
+
+/**
+ * @brief Round up to the next multiple of eight
+ */
+INLINED static uint64_t htable_snapshot_align(uint64_t offs)
+{
+  return (offs + 7) & ~((uint64_t) 7);
+}
+
+/**
+ * @brief Write bytes followed by zero-padding up to the next multiple of eight
+ *
+ * @param f File to write to
+ * @param data Bytes to write
+ * @param len Number of bytes
+ * @param offs Current file offset, gets updated in place
+ *
+ * @return true All bytes have been written
+ * @return false An I/O error occurred
+ */
+static bool htable_snapshot_write(FILE *f, const void *data, size_t len, uint64_t *offs)
+{
+  static const char padding[8] = { 0 };
+  size_t pad = htable_snapshot_align(*offs + len) - (*offs + len);
+
+  if (len && fwrite(data, 1, len, f) != len) return false;
+  if (pad && fwrite(padding, 1, pad, f) != pad) return false;
+
+  *offs += len + pad;
+  return true;
+}
+
+/**
+ * @brief Write all entries of a table into an opened snapshot file
+ */
+static bool htable_snapshot_write_all(htable_t *table, FILE *f, htable_value_serializer_f value_serializer)
+{
+  scptr htable_entry_t **entries = NULL;
+  size_t num_entries = htable_list_entries(table, &entries);
+
+  htable_snapshot_header_t header;
+  memcpy(header.magic, HTABLE_SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = HTABLE_SNAPSHOT_VERSION;
+  header.flags = table->_int_keys ? HTABLE_SNAPSHOT_INT_KEYS : 0;
+  header.item_count = num_entries;
+  header.slot_count = u64_max(num_entries, 1);
+
+  // Slots are written as placeholders first and rewritten once all chains are known
+  scptr uint64_t *slots = (uint64_t *) mman_calloc(sizeof(uint64_t), header.slot_count, NULL);
+  uint64_t offs = 0;
+  if (!htable_snapshot_write(f, &header, sizeof(header), &offs)) return false;
+  if (!htable_snapshot_write(f, slots, sizeof(uint64_t) * header.slot_count, &offs)) return false;
+
+  for (size_t i = 0; i < num_entries; i++)
+  {
+    htable_entry_t *entry = entries[i];
+
+    // Serialize the value, strings by default
+    size_t value_size;
+    scptr void *value = NULL;
+    const void *value_bytes = entry->value;
+    if (value_serializer)
+    {
+      value = value_serializer(entry->value, &value_size);
+      if (!value) return false;
+      value_bytes = value;
+    }
+    else
+      value_size = strlen((char *) entry->value) + 1;
+
+    // Prepend to the chain of it's slot, the previous head has already been written
+    uint64_t *slot = &slots[entry->_hash % header.slot_count];
+    htable_snapshot_entry_t record = {
+      .hash = entry->_hash,
+      .next = *slot,
+      .key = table->_int_keys ? entry->int_key : entry->key_len,
+      .value_size = value_size
+    };
+    *slot = offs;
+
+    if (!htable_snapshot_write(f, &record, sizeof(record), &offs)) return false;
+    if (!table->_int_keys && !htable_snapshot_write(f, entry->key, entry->key_len + 1, &offs)) return false;
+    if (!htable_snapshot_write(f, value_bytes, value_size, &offs)) return false;
+  }
+
+  // Write the now known slot heads
+  if (fseek(f, sizeof(header), SEEK_SET) != 0) return false;
+  return fwrite(slots, sizeof(uint64_t), header.slot_count, f) == header.slot_count;
+}
+
+htable_result_t htable_save(htable_t *table, const char *path, htable_value_serializer_f value_serializer)
+{
+  // Write next to the target, so readers never see a partial file
+  scptr char *tmp_path = strfmt_direct("%s.tmp", path);
+  FILE *f = fopen(tmp_path, "wb");
+  if (!f) return HTABLE_IO_ERROR;
+
+  bool written = htable_snapshot_write_all(table, f, value_serializer);
+  if (fclose(f) != 0) written = false;
+
+  if (!written || rename(tmp_path, path) != 0)
+  {
+    remove(tmp_path);
+    return HTABLE_IO_ERROR;
+  }
+
+  return HTABLE_SUCCESS;
+}
+
+/**
+ * @brief Unmap a no longer needed snapshot
+ */
+static void htable_mapped_cleanup(mman_meta_t *ref)
+{
+  htable_mapped_t *mapped = (htable_mapped_t *) ref->ptr;
+  munmap((void *) mapped->header, mapped->_size);
+}
+
+htable_mapped_t *htable_map(const char *path)
+{
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return NULL;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(htable_snapshot_header_t))
+  {
+    close(fd);
+    return NULL;
+  }
+
+  // The mapping stays valid after closing it's descriptor
+  size_t size = (size_t) st.st_size;
+  void *base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) return NULL;
+
+  // Validate the header and the slot offsets' bounds
+  const htable_snapshot_header_t *header = (const htable_snapshot_header_t *) base;
+  if (
+    memcmp(header->magic, HTABLE_SNAPSHOT_MAGIC, sizeof(header->magic)) != 0
+    || header->version != HTABLE_SNAPSHOT_VERSION
+    || header->slot_count == 0
+    || header->slot_count > (size - sizeof(htable_snapshot_header_t)) / sizeof(uint64_t)
+  )
+  {
+    munmap(base, size);
+    return NULL;
+  }
+
+  scptr htable_mapped_t *mapped = (htable_mapped_t *) mman_alloc(sizeof(htable_mapped_t), 1, htable_mapped_cleanup);
+  mapped->header = header;
+  mapped->slots = (const uint64_t *) (header + 1);
+  mapped->_size = size;
+  return (htable_mapped_t *) mman_ref(mapped);
+}
+
+htable_result_t htable_mapped_fetch_key(htable_mapped_t *mapped, htable_key_t *key, const void **value, size_t *size)
+{
+  *value = NULL;
+
+  // Snapshots only ever contain keys of their table's type
+  bool int_keys = (mapped->header->flags & HTABLE_SNAPSHOT_INT_KEYS) != 0;
+  if (key->is_int != int_keys) return HTABLE_KEY_TYPE_MISMATCH;
+
+  const char *base = (const char *) mapped->header;
+  uint64_t offs = mapped->slots[key->hash % mapped->header->slot_count];
+
+  // Traverse the chain by file offsets, never leaving the mapping
+  while (offs && offs <= mapped->_size - sizeof(htable_snapshot_entry_t))
+  {
+    const htable_snapshot_entry_t *record = (const htable_snapshot_entry_t *) (base + offs);
+    uint64_t key_size = int_keys ? 0 : htable_snapshot_align(record->key + 1);
+    uint64_t value_offs = offs + sizeof(htable_snapshot_entry_t) + key_size;
+
+    // Corrupted key size
+    if (value_offs > mapped->_size) return HTABLE_KEY_NOT_FOUND;
+
+    bool matches = record->hash == key->hash && (
+      int_keys
+      ? record->key == key->int_key
+      : record->key == key->len && memcmp(record + 1, key->bytes, key->len) == 0
+    );
+
+    if (matches)
+    {
+      // Corrupted value size
+      if (record->value_size > mapped->_size - value_offs)
+        return HTABLE_KEY_NOT_FOUND;
+
+      *value = base + value_offs;
+      if (size) *size = record->value_size;
+      return HTABLE_SUCCESS;
+    }
+
+    // Chains always point backwards in the file, which rules out cycles
+    if (record->next >= offs) break;
+    offs = record->next;
+  }
+
+  return HTABLE_KEY_NOT_FOUND;
+}
+
+htable_result_t htable_mapped_fetch(htable_mapped_t *mapped, const char *key, const void **value, size_t *size)
+{
+  htable_key_t k = htable_key_str(key);
+  return htable_mapped_fetch_key(mapped, &k, value, size);
+}
@@ -0,0 +1,54 @@
+#include "blvckstd/htable.h"
+
+/*
+============================================================================
+                               Introspection
+============================================================================
+*/
+
+void htable_stats(htable_t *table, htable_stats_t *output)
+{
+  memset(output, 0, sizeof(htable_stats_t));
+  output->item_count = table->_item_count;
+
+  output->lookups = table->_lookups;
+  output->probes = table->_probes;
+
+  // Frozen tables hold exactly one entry per slot
+  if (table->_frozen)
+  {
+    size_t entries = table->_frozen->_entry_count;
+    output->slot_count = entries;
+    output->load_factor = entries ? 1.0 : 0.0;
+    output->chain_hist[1] = entries;
+    output->max_chain = entries ? 1 : 0;
+    output->avg_probes = entries ? 1.0 : 0.0;
+    return;
+  }
+
+  output->slot_count = table->_slot_count;
+  output->load_factor = (double) table->_item_count / (double) table->_slot_count;
+
+  // Finding the k-th link of a chain compares k entries, so a chain
+  // of length l takes l * (l + 1) / 2 probes to find all of it's entries
+  size_t total_probes = 0;
+  for (size_t i = 0; i < table->_slot_count; i++)
+  {
+    size_t length = 0;
+    for (htable_entry_t *entry = table->slots[i]; entry; entry = entry->_next)
+      length++;
+
+    if (length == 0) output->empty_slots++;
+    output->chain_hist[u64_min(length, HTABLE_STATS_HIST_LEN - 1)]++;
+    output->max_chain = u64_max(output->max_chain, length);
+    total_probes += length * (length + 1) / 2;
+  }
+
+  if (table->_item_count)
+    output->avg_probes = (double) total_probes / (double) table->_item_count;
+}
+
+void htable_set_probe_stats(htable_t *table, bool enabled)
+{
+  table->_probe_stats = enabled;
+}
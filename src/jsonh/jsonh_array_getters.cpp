@@ -11,7 +11,11 @@ INLINED static jsonh_opres_t jsonh_get_arr_value(dynarr_t *array, int index, jso
   if (index < 0 || index >= array->_array_size)
     return JOPRES_INVALID_INDEX;
 
+  // Empty slot
   jsonh_value_t *value = (jsonh_value_t *) array->items[index];
+  if (!value)
+    return JOPRES_INVALID_INDEX;
+
   if (value->type != dt)
     return JOPRES_DTYPE_MISMATCH;
 
@@ -397,8 +397,8 @@ bool jsonh_parse_arr(jsonh_cursor_t *cursor, char **err, dynarr_t **out)
 
   jsonh_parse_eat_whitespace(cursor);
 
-  // Parse values until the end of array is reached
-  scptr dynarr_t *arr = dynarr_make(16, 1024, mman_dealloc_nr);
+  // Parse values until the end of array is reached, short arrays stay inline
+  scptr dynarr_t *arr = dynarr_make_dense(DYNARR_INLINE_SLOTS, JSONH_ARR_ITEM_CAP, mman_dealloc_nr);
   while ((curr = jsonh_cursor_peekc(cursor)).c != ']')
   {
     jsonh_parse_eat_whitespace(cursor);
@@ -154,20 +154,19 @@ static void jsonh_stringify_arr(dynarr_t *arr, int indent, int indent_level, cha
   scptr char *indent_str = jsonh_gen_indent(indent * indent_level);
   scptr char *indent_str_outer = jsonh_gen_indent(indent * u64_max(0, (uint64_t) indent_level - 1U));
 
-  // Get all array values
-  scptr void **arr_vals = NULL;
-  dynarr_as_array(arr, &arr_vals);
-  
-  // Iterate array values
-  for (void **arr_v = arr_vals; *arr_v; arr_v++)
+  // Iterate array values in place, separators lead all but the first value
+  bool first = true;
+  DYNARR_FOREACH(arr, it)
   {
-    jsonh_value_t *jv = (jsonh_value_t *) *arr_v;
-    const char *sep = *(arr_v + 1) == NULL ? "" : ",";
-    strfmt(buf, buf_offs, "%s", indent_str);
+    jsonh_value_t *jv = (jsonh_value_t *) it.item;
+    strfmt(buf, buf_offs, "%s%s", first ? "" : ",\n", indent_str);
     jsonh_stringify_value(jv, indent, indent_level, buf, buf_offs);
-    strfmt(buf, buf_offs, "%s\n", sep);
+    first = false;
   }
 
+  // Terminate the last value's line
+  if (!first) strfmt(buf, buf_offs, "\n");
+
   strfmt(buf, buf_offs, "%s]", indent_str_outer);
 }
 
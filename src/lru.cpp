@@ -0,0 +1,228 @@
+#include "blvckstd/lru.h"
+
+ENUM_LUT_FULL_IMPL(lru_result, _EVALS_LRU_RESULT);
+
+/**
+ * @brief Get the current monotonic time in milliseconds
+ */
+INLINED static uint64_t lru_now_ms()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000 + (uint64_t) ts.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Unlink a node from the recency list
+ */
+INLINED static void lru_unlink(lru_t *lru, lru_node_t *node)
+{
+  if (node->_prev) node->_prev->_next = node->_next;
+  else lru->_head = node->_next;
+
+  if (node->_next) node->_next->_prev = node->_prev;
+  else lru->_tail = node->_prev;
+
+  node->_prev = NULL;
+  node->_next = NULL;
+}
+
+/**
+ * @brief Link a node in as the most recently used one
+ */
+INLINED static void lru_link_head(lru_t *lru, lru_node_t *node)
+{
+  node->_prev = NULL;
+  node->_next = lru->_head;
+
+  if (lru->_head) lru->_head->_prev = node;
+  else lru->_tail = node;
+
+  lru->_head = node;
+}
+
+/**
+ * @brief Drop a node from the cache entirely
+ *
+ * @param lru Cache reference
+ * @param node Node to drop
+ * @param evicted Whether to invoke the eviction callback
+ */
+static void lru_drop(lru_t *lru, lru_node_t *node, bool evicted)
+{
+  if (evicted && lru->_evict_cb) lru->_evict_cb(node->value);
+  if (lru->_cf) lru->_cf(node->value);
+
+  // The key points into the table's entry, so unlink before removing it
+  lru_unlink(lru, node);
+  htable_remove_key(lru->table, &node->key);
+
+  lru->_count--;
+  lru->_bytes -= node->size;
+  mman_dealloc(node);
+}
+
+/**
+ * @brief Clean up a no longer needed cache and all of it's values
+ */
+static void lru_cleanup(mman_meta_t *ref)
+{
+  lru_t *lru = (lru_t *) ref->ptr;
+
+  // The table holds no cleanup function, nodes are freed here
+  for (lru_node_t *node = lru->_head; node;)
+  {
+    lru_node_t *next = node->_next;
+    if (lru->_cf) lru->_cf(node->value);
+    mman_dealloc(node);
+    node = next;
+  }
+
+  mman_dealloc(lru->table);
+}
+
+lru_t *lru_make(size_t max_entries, size_t max_bytes, clfn_t cf, clfn_t evict_cb)
+{
+  scptr lru_t *lru = (lru_t *) mman_alloc(sizeof(lru_t), 1, lru_cleanup);
+
+  // Without an entry limit, start out small and let the table grow without bounds
+  if (max_entries)
+    lru->table = htable_make(max_entries, NULL); // needs mman freeing
+  else
+    lru->table = htable_make_unbounded(LRU_UNBOUNDED_INITIAL_ENTRIES, NULL); // needs mman freeing
+
+  lru->_head = NULL; // No freeing
+  lru->_tail = NULL; // No freeing
+  lru->_count = 0; // No freeing
+  lru->_max_entries = max_entries; // No freeing
+  lru->_bytes = 0; // No freeing
+  lru->_max_bytes = max_bytes; // No freeing
+  lru->_cf = cf; // No freeing
+  lru->_evict_cb = evict_cb; // No freeing
+
+  return (lru_t *) mman_ref(lru);
+}
+
+lru_result_t lru_put(lru_t *lru, const char *key, void *value, size_t size, uint64_t ttl_ms)
+{
+  // Tried to insert a null value
+  if (!value) return LRU_NULL_VALUE;
+
+  // Would never fit, even into an empty cache
+  if (lru->_max_bytes && size > lru->_max_bytes) return LRU_TOO_LARGE;
+
+  // Hash once, the key is reused for the lookup as well as the insertion
+  htable_key_t k = htable_key_str(key);
+  if (k.len > HTABLE_MAX_KEYLEN) return LRU_KEY_TOO_LONG;
+
+  uint64_t expires_at = ttl_ms ? lru_now_ms() + ttl_ms : 0;
+
+  // Replace the value of an existing node in place
+  lru_node_t *node = NULL;
+  if (htable_fetch_key(lru->table, &k, (void **) &node) == HTABLE_SUCCESS)
+  {
+    if (lru->_cf && node->value != value) lru->_cf(node->value);
+
+    lru->_bytes = lru->_bytes - node->size + size;
+    node->value = value;
+    node->size = size;
+    node->expires_at = expires_at;
+
+    lru_unlink(lru, node);
+    lru_link_head(lru, node);
+  }
+
+  // Make room for a new node
+  else
+  {
+    while (lru->_tail && lru->_max_entries && lru->_count >= lru->_max_entries)
+      lru_drop(lru, lru->_tail, true);
+
+    node = (lru_node_t *) mman_alloc(sizeof(lru_node_t), 1, NULL);
+    node->value = value;
+    node->size = size;
+    node->expires_at = expires_at;
+
+    htable_entry_t *entry;
+    if (htable_insert_entry(lru->table, &k, node, &entry) != HTABLE_SUCCESS)
+    {
+      mman_dealloc(node);
+      return LRU_FULL;
+    }
+
+    // Point the node's key at the table's copy
+    node->key = htable_entry_key(entry, false);
+
+    lru_link_head(lru, node);
+    lru->_count++;
+    lru->_bytes += size;
+  }
+
+  // Evict from the tail until the byte limit is satisfied, never evicting the new node
+  while (lru->_max_bytes && lru->_bytes > lru->_max_bytes && lru->_tail != node)
+    lru_drop(lru, lru->_tail, true);
+
+  return LRU_SUCCESS;
+}
+
+lru_result_t lru_get(lru_t *lru, const char *key, void **output)
+{
+  *output = NULL;
+
+  lru_node_t *node = NULL;
+  if (htable_fetch(lru->table, key, (void **) &node) != HTABLE_SUCCESS)
+    return LRU_KEY_NOT_FOUND;
+
+  // Expired values are evicted lazily on access
+  if (node->expires_at && node->expires_at <= lru_now_ms())
+  {
+    lru_drop(lru, node, true);
+    return LRU_EXPIRED;
+  }
+
+  // Mark as most recently used
+  if (lru->_head != node)
+  {
+    lru_unlink(lru, node);
+    lru_link_head(lru, node);
+  }
+
+  *output = node->value;
+  return LRU_SUCCESS;
+}
+
+lru_result_t lru_remove(lru_t *lru, const char *key)
+{
+  lru_node_t *node = NULL;
+  if (htable_fetch(lru->table, key, (void **) &node) != HTABLE_SUCCESS)
+    return LRU_KEY_NOT_FOUND;
+
+  lru_drop(lru, node, false);
+  return LRU_SUCCESS;
+}
+
+size_t lru_prune_expired(lru_t *lru)
+{
+  uint64_t now = lru_now_ms();
+  size_t num_evicted = 0;
+
+  for (lru_node_t *node = lru->_head; node;)
+  {
+    lru_node_t *next = node->_next;
+
+    if (node->expires_at && node->expires_at <= now)
+    {
+      lru_drop(lru, node, true);
+      num_evicted++;
+    }
+
+    node = next;
+  }
+
+  return num_evicted;
+}
+
+size_t lru_count(lru_t *lru)
+{
+  return lru->_count;
+}
@@ -0,0 +1,229 @@
+#include "blvckstd/mpmc.h"
+
+/**
+ * @brief Get the sequence number of the cell at a position
+ */
+INLINED static volatile size_t *mpmc_seq(mpmc_t *queue, size_t pos)
+{
+  return (volatile size_t *) (queue->cells + (pos & queue->_mask) * queue->_cell_size);
+}
+
+/**
+ * @brief Get the item of the cell at a position
+ */
+INLINED static char *mpmc_item(mpmc_t *queue, size_t pos)
+{
+  return queue->cells + (pos & queue->_mask) * queue->_cell_size + sizeof(size_t);
+}
+
+/**
+ * @brief Clean up a no longer needed mpmc struct and all items left over
+ */
+INLINED static void mpmc_cleanup(mman_meta_t *ref)
+{
+  mpmc_t *queue = (mpmc_t *) ref->ptr;
+
+  // Only called once no other thread has access anymore
+  if (queue->_cf)
+  {
+    for (size_t pos = queue->_tail; pos != queue->_head; pos++)
+      queue->_cf(mpmc_item(queue, pos));
+  }
+
+  mman_dealloc(queue->cells);
+}
+
+mpmc_t *mpmc_make(size_t capacity, size_t item_size, clfn_t cf)
+{
+  scptr mpmc_t *res = (mpmc_t *) mman_alloc(sizeof(mpmc_t), 1, mpmc_cleanup);
+
+  // Round up to the next power of two, at least two cells are needed
+  size_t cells = 2;
+  while (cells < capacity) cells *= 2;
+
+  res->_cell_size = (sizeof(size_t) + item_size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1); // no freeing
+  res->_item_size = item_size; // no freeing
+  res->_mask = cells - 1; // no freeing
+  res->_cf = cf; // no freeing
+  res->_head = 0; // no freeing
+  res->_tail = 0; // no freeing
+
+  // Each cell is ready to be pushed to in the first lap
+  res->cells = (char *) mman_alloc(res->_cell_size, cells, NULL); // needs mman freeing
+  for (size_t i = 0; i < cells; i++)
+    *mpmc_seq(res, i) = i;
+
+  return (mpmc_t *) mman_ref(res);
+}
+
+bool mpmc_try_push(mpmc_t *queue, const void *item)
+{
+  size_t pos = atomic_load_acquire(&queue->_head);
+
+  while (true)
+  {
+    volatile size_t *seq = mpmc_seq(queue, pos);
+    intptr_t dif = (intptr_t) atomic_load_acquire(seq) - (intptr_t) pos;
+
+    // Cell is ready for this lap, try to claim the position
+    if (dif == 0)
+    {
+      if (atomic_cas(&queue->_head, pos, pos + 1))
+      {
+        memcpy(mpmc_item(queue, pos), item, queue->_item_size);
+
+        // Hand the cell to the consumer of this lap
+        atomic_store_release(seq, pos + 1);
+        return true;
+      }
+    }
+
+    // Cell still holds the previous lap's item
+    else if (dif < 0)
+      return false;
+
+    // Another producer claimed the position in the meantime
+    pos = atomic_load_acquire(&queue->_head);
+  }
+}
+
+bool mpmc_try_pop(mpmc_t *queue, void *out)
+{
+  size_t pos = atomic_load_acquire(&queue->_tail);
+
+  while (true)
+  {
+    volatile size_t *seq = mpmc_seq(queue, pos);
+    intptr_t dif = (intptr_t) atomic_load_acquire(seq) - (intptr_t) (pos + 1);
+
+    // Cell has been written in this lap, try to claim the position
+    if (dif == 0)
+    {
+      if (atomic_cas(&queue->_tail, pos, pos + 1))
+      {
+        memcpy(out, mpmc_item(queue, pos), queue->_item_size);
+
+        // Hand the cell to the producer of the next lap
+        atomic_store_release(seq, pos + queue->_mask + 1);
+        return true;
+      }
+    }
+
+    // Cell hasn't been written yet
+    else if (dif < 0)
+      return false;
+
+    // Another consumer claimed the position in the meantime
+    pos = atomic_load_acquire(&queue->_tail);
+  }
+}
+
+/**
+ * @brief Back off after a failed attempt, spinning first and yielding later on
+ */
+INLINED static void mpmc_backoff(size_t *attempts)
+{
+  if (++(*attempts) >= MPMC_SPIN_LIMIT)
+    sched_yield();
+}
+
+void mpmc_push(mpmc_t *queue, const void *item)
+{
+  size_t attempts = 0;
+  while (!mpmc_try_push(queue, item))
+    mpmc_backoff(&attempts);
+}
+
+void mpmc_pop(mpmc_t *queue, void *out)
+{
+  size_t attempts = 0;
+  while (!mpmc_try_pop(queue, out))
+    mpmc_backoff(&attempts);
+}
+
+size_t mpmc_try_push_n(mpmc_t *queue, const void *items, size_t count)
+{
+  const char *item = (const char *) items;
+  if (count == 0)
+    return 0;
+
+  size_t pos = atomic_load_acquire(&queue->_head);
+
+  while (true)
+  {
+    // Count the contiguous cells ready for this lap, no other producer can take them without claiming first
+    size_t num_ready = 0;
+    while (num_ready < count && atomic_load_acquire(mpmc_seq(queue, pos + num_ready)) == pos + num_ready)
+      num_ready++;
+
+    if (num_ready == 0)
+    {
+      // Cell still holds the previous lap's item
+      if ((intptr_t) atomic_load_acquire(mpmc_seq(queue, pos)) - (intptr_t) pos < 0)
+        return 0;
+    }
+
+    // Claim the whole range at once
+    else if (atomic_cas(&queue->_head, pos, pos + num_ready))
+    {
+      for (size_t i = 0; i < num_ready; i++)
+      {
+        memcpy(mpmc_item(queue, pos + i), item + i * queue->_item_size, queue->_item_size);
+        atomic_store_release(mpmc_seq(queue, pos + i), pos + i + 1);
+      }
+
+      return num_ready;
+    }
+
+    // Another producer claimed the position in the meantime
+    pos = atomic_load_acquire(&queue->_head);
+  }
+}
+
+size_t mpmc_try_pop_n(mpmc_t *queue, void *out, size_t count)
+{
+  char *buf = (char *) out;
+  if (count == 0)
+    return 0;
+
+  size_t pos = atomic_load_acquire(&queue->_tail);
+
+  while (true)
+  {
+    // Count the contiguous cells written in this lap, no other consumer can take them without claiming first
+    size_t num_ready = 0;
+    while (num_ready < count && atomic_load_acquire(mpmc_seq(queue, pos + num_ready)) == pos + num_ready + 1)
+      num_ready++;
+
+    if (num_ready == 0)
+    {
+      // Cell hasn't been written yet
+      if ((intptr_t) atomic_load_acquire(mpmc_seq(queue, pos)) - (intptr_t) (pos + 1) < 0)
+        return 0;
+    }
+
+    // Claim the whole range at once
+    else if (atomic_cas(&queue->_tail, pos, pos + num_ready))
+    {
+      for (size_t i = 0; i < num_ready; i++)
+      {
+        memcpy(buf + i * queue->_item_size, mpmc_item(queue, pos + i), queue->_item_size);
+        atomic_store_release(mpmc_seq(queue, pos + i), pos + i + queue->_mask + 1);
+      }
+
+      return num_ready;
+    }
+
+    // Another consumer claimed the position in the meantime
+    pos = atomic_load_acquire(&queue->_tail);
+  }
+}
+
+size_t mpmc_length(mpmc_t *queue)
+{
+  size_t tail = atomic_load_acquire(&queue->_tail);
+  size_t head = atomic_load_acquire(&queue->_head);
+
+  // Ends are read one after the other and might have passed each other
+  return head > tail ? head - tail : 0;
+}
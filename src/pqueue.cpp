@@ -0,0 +1,224 @@
+#include "blvckstd/pqueue.h"
+
+ENUM_LUT_FULL_IMPL(pqueue_result, _EVALS_PQUEUE_RESULT);
+
+/**
+ * @brief Clean up a no longer needed pqueue struct and all of it's items
+ */
+INLINED static void pqueue_cleanup(mman_meta_t *ref)
+{
+  pqueue_t *pq = (pqueue_t *) ref->ptr;
+
+  if (pq->_cf)
+  {
+    for (size_t i = 0; i < pq->_length; i++)
+      pq->_cf(pq->items[i]);
+  }
+
+  mman_dealloc(pq->items);
+  mman_dealloc(pq->_handles);
+  mman_dealloc(pq->_positions);
+}
+
+pqueue_t *pqueue_make(size_t array_size, size_t array_max_size, pqueue_cmp_f cmp, clfn_t cf)
+{
+  scptr pqueue_t *res = (pqueue_t *) mman_alloc(sizeof(pqueue_t), 1, pqueue_cleanup);
+
+  // At least one item fits, the cap never lies below the allocated size
+  array_size = u64_max(u64_min(array_size, array_max_size), 1);
+  array_max_size = u64_max(array_max_size, array_size);
+
+  res->_length = 0; // no freeing
+  res->_handle_count = 0; // no freeing
+  res->_free_head = SIZE_MAX; // no freeing
+  res->_array_size = array_size; // no freeing
+  res->_array_cap = array_max_size; // no freeing
+  res->_cmp = cmp; // no freeing
+  res->_cf = cf; // no freeing
+
+  // Entries are only valid up to the length or handle count, no need to initialize
+  res->items = (void **) mman_alloc(sizeof(void *), array_size, NULL); // needs mman freeing
+  res->_handles = (size_t *) mman_alloc(sizeof(size_t), array_size, NULL); // needs mman freeing
+  res->_positions = (size_t *) mman_alloc(sizeof(size_t), array_size, NULL); // needs mman freeing
+
+  return (pqueue_t *) mman_ref(res);
+}
+
+static bool pqueue_try_resize(pqueue_t *pq)
+{
+  if (pq->_array_size >= pq->_array_cap) return false;
+  size_t rem_cap = pq->_array_cap - pq->_array_size;
+
+  // Try to double the amount of items, go straight to the cap otherwise
+  size_t new_size = pq->_array_size + u64_min(pq->_array_size, rem_cap);
+
+  pq->items = (void **) mman_realloc((void **) &pq->items, sizeof(void *), new_size)->ptr;
+  pq->_handles = (size_t *) mman_realloc((void **) &pq->_handles, sizeof(size_t), new_size)->ptr;
+  pq->_positions = (size_t *) mman_realloc((void **) &pq->_positions, sizeof(size_t), new_size)->ptr;
+  pq->_array_size = new_size;
+  return true;
+}
+
+/**
+ * @brief Put an item and it's handle at a heap position
+ */
+INLINED static void pqueue_place(pqueue_t *pq, size_t pos, void *item, size_t handle)
+{
+  pq->items[pos] = item;
+  pq->_handles[pos] = handle;
+  pq->_positions[handle] = pos;
+}
+
+/**
+ * @brief Move an item towards the root while it comes before it's parent
+ *
+ * @return size_t Final position
+ */
+static size_t pqueue_sift_up(pqueue_t *pq, size_t pos)
+{
+  void *item = pq->items[pos];
+  size_t handle = pq->_handles[pos];
+
+  // Shift parents down instead of swapping, placing the item once at the end
+  while (pos > 0)
+  {
+    size_t parent = (pos - 1) / PQUEUE_ARITY;
+    if (pq->_cmp(item, pq->items[parent]) >= 0) break;
+
+    pqueue_place(pq, pos, pq->items[parent], pq->_handles[parent]);
+    pos = parent;
+  }
+
+  pqueue_place(pq, pos, item, handle);
+  return pos;
+}
+
+/**
+ * @brief Move an item towards the leaves while any of it's children comes before it
+ */
+static void pqueue_sift_down(pqueue_t *pq, size_t pos)
+{
+  void *item = pq->items[pos];
+  size_t handle = pq->_handles[pos];
+
+  while (true)
+  {
+    size_t first = pos * PQUEUE_ARITY + 1;
+    if (first >= pq->_length) break;
+
+    // Find the child coming first
+    size_t last = u64_min(first + PQUEUE_ARITY, pq->_length);
+    size_t best = first;
+    for (size_t child = first + 1; child < last; child++)
+    {
+      if (pq->_cmp(pq->items[child], pq->items[best]) < 0)
+        best = child;
+    }
+
+    if (pq->_cmp(pq->items[best], item) >= 0) break;
+
+    pqueue_place(pq, pos, pq->items[best], pq->_handles[best]);
+    pos = best;
+  }
+
+  pqueue_place(pq, pos, item, handle);
+}
+
+/**
+ * @brief Check whether a handle is in use, as far as this can be told
+ */
+INLINED static bool pqueue_handle_valid(pqueue_t *pq, size_t handle)
+{
+  if (handle >= pq->_handle_count) return false;
+
+  size_t pos = pq->_positions[handle];
+  return pos < pq->_length && pq->_handles[pos] == handle;
+}
+
+pqueue_result_t pqueue_push(pqueue_t *pq, void *item, size_t *handle)
+{
+  // Reuse the most recently freed handle, take a new one into use otherwise
+  size_t h = pq->_free_head;
+  if (h == SIZE_MAX)
+  {
+    if (pq->_handle_count == pq->_array_size && !pqueue_try_resize(pq))
+      return PQUEUE_FULL;
+
+    h = pq->_handle_count++;
+  }
+  else
+    pq->_free_head = pq->_positions[h];
+
+  pqueue_place(pq, pq->_length, item, h);
+  pqueue_sift_up(pq, pq->_length++);
+
+  if (handle) *handle = h;
+  return PQUEUE_SUCCESS;
+}
+
+void *pqueue_peek(pqueue_t *pq)
+{
+  return pq->_length ? pq->items[0] : NULL;
+}
+
+pqueue_result_t pqueue_pop(pqueue_t *pq, void **out)
+{
+  if (pq->_length == 0) return PQUEUE_EMPTY;
+  return pqueue_remove(pq, pq->_handles[0], out);
+}
+
+void *pqueue_get(pqueue_t *pq, size_t handle)
+{
+  if (!pqueue_handle_valid(pq, handle)) return NULL;
+  return pq->items[pq->_positions[handle]];
+}
+
+pqueue_result_t pqueue_decrease_key(pqueue_t *pq, size_t handle)
+{
+  if (!pqueue_handle_valid(pq, handle)) return PQUEUE_INVALID_HANDLE;
+
+  pqueue_sift_up(pq, pq->_positions[handle]);
+  return PQUEUE_SUCCESS;
+}
+
+pqueue_result_t pqueue_update(pqueue_t *pq, size_t handle)
+{
+  if (!pqueue_handle_valid(pq, handle)) return PQUEUE_INVALID_HANDLE;
+
+  // Only sift down if the item didn't move up
+  size_t pos = pq->_positions[handle];
+  if (pqueue_sift_up(pq, pos) == pos)
+    pqueue_sift_down(pq, pos);
+
+  return PQUEUE_SUCCESS;
+}
+
+pqueue_result_t pqueue_remove(pqueue_t *pq, size_t handle, void **out)
+{
+  if (!pqueue_handle_valid(pq, handle)) return PQUEUE_INVALID_HANDLE;
+
+  size_t pos = pq->_positions[handle];
+  void *item = pq->items[pos];
+
+  // Fill the gap with the last item and restore it's order
+  size_t last = --pq->_length;
+  if (pos != last)
+  {
+    pqueue_place(pq, pos, pq->items[last], pq->_handles[last]);
+    if (pqueue_sift_up(pq, pos) == pos)
+      pqueue_sift_down(pq, pos);
+  }
+
+  // Free the handle
+  pq->_positions[handle] = pq->_free_head;
+  pq->_free_head = handle;
+
+  if (out) *out = item;
+  else if (pq->_cf) pq->_cf(item);
+  return PQUEUE_SUCCESS;
+}
+
+size_t pqueue_length(pqueue_t *pq)
+{
+  return pq->_length;
+}
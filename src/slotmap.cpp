@@ -0,0 +1,140 @@
+#include "blvckstd/slotmap.h"
+
+/**
+ * @brief Clean up all values of a slotmap
+ */
+INLINED static void slotmap_cleanup_values(slotmap_t *map)
+{
+  if (!map->_cf) return;
+
+  for (size_t i = 0; i < map->_length; i++)
+    map->_cf(map->values[i]);
+}
+
+/**
+ * @brief Clean up a no longer needed slotmap struct and all of it's values
+ */
+INLINED static void slotmap_cleanup(mman_meta_t *ref)
+{
+  slotmap_t *map = (slotmap_t *) ref->ptr;
+  slotmap_cleanup_values(map);
+
+  mman_dealloc(map->values);
+  mman_dealloc(map->_value_slots);
+  mman_dealloc(map->_slots);
+}
+
+slotmap_t *slotmap_make(size_t array_size, size_t array_max_size, clfn_t cf)
+{
+  scptr slotmap_t *res = (slotmap_t *) mman_alloc(sizeof(slotmap_t), 1, slotmap_cleanup);
+
+  // Slot indices have to fit into handles
+  array_max_size = u64_min(array_max_size, SLOTMAP_NO_SLOT);
+  // At least one slot fits, the cap never lies below the allocated size
+  array_size = u64_max(u64_min(array_size, array_max_size), 1);
+  array_max_size = u64_max(array_max_size, array_size);
+
+  res->_length = 0; // no freeing
+  res->_slot_count = 0; // no freeing
+  res->_free_head = SLOTMAP_NO_SLOT; // no freeing
+  res->_array_size = array_size; // no freeing
+  res->_array_cap = array_max_size; // no freeing
+  res->_cf = cf; // no freeing
+
+  // Entries are only valid up to the length or slot count, no need to initialize
+  res->values = (void **) mman_alloc(sizeof(void *), array_size, NULL); // needs mman freeing
+  res->_value_slots = (uint32_t *) mman_alloc(sizeof(uint32_t), array_size, NULL); // needs mman freeing
+  res->_slots = (slotmap_slot_t *) mman_alloc(sizeof(slotmap_slot_t), array_size, NULL); // needs mman freeing
+
+  return (slotmap_t *) mman_ref(res);
+}
+
+static bool slotmap_try_resize(slotmap_t *map)
+{
+  if (map->_array_size >= map->_array_cap) return false;
+  size_t rem_cap = map->_array_cap - map->_array_size;
+
+  // Try to double the amount of slots, go straight to the cap otherwise
+  size_t new_size = map->_array_size + u64_min(map->_array_size, rem_cap);
+
+  map->values = (void **) mman_realloc((void **) &map->values, sizeof(void *), new_size)->ptr;
+  map->_value_slots = (uint32_t *) mman_realloc((void **) &map->_value_slots, sizeof(uint32_t), new_size)->ptr;
+  map->_slots = (slotmap_slot_t *) mman_realloc((void **) &map->_slots, sizeof(slotmap_slot_t), new_size)->ptr;
+  map->_array_size = new_size;
+  return true;
+}
+
+dynarr_result_t slotmap_insert(slotmap_t *map, void *item, slotmap_handle_t *handle)
+{
+  if (!item) return DYNARR_NULL_ITEM;
+
+  // Reuse the most recently freed slot, take a new one into use otherwise
+  uint32_t index = map->_free_head;
+  if (index == SLOTMAP_NO_SLOT)
+  {
+    if (map->_slot_count == map->_array_size && !slotmap_try_resize(map))
+      return DYNARR_FULL;
+
+    index = map->_slot_count++;
+    map->_slots[index].generation = 0;
+  }
+  else
+    map->_free_head = map->_slots[index].target;
+
+  // Append the value
+  slotmap_slot_t *slot = &map->_slots[index];
+  slot->target = map->_length;
+  map->values[map->_length] = item;
+  map->_value_slots[map->_length] = index;
+  map->_length++;
+
+  handle->index = index;
+  handle->generation = slot->generation;
+  return DYNARR_SUCCESS;
+}
+
+dynarr_result_t slotmap_remove(slotmap_t *map, slotmap_handle_t handle, void **out)
+{
+  void *item = slotmap_get(map, handle);
+  if (!item) return DYNARR_INDEX_NOT_FOUND;
+
+  if (out) *out = item;
+  else if (map->_cf) map->_cf(item);
+
+  // Move the last value into the gap and redirect it's slot
+  slotmap_slot_t *slot = &map->_slots[handle.index];
+  uint32_t last = --map->_length;
+  if (slot->target != last)
+  {
+    map->values[slot->target] = map->values[last];
+    map->_value_slots[slot->target] = map->_value_slots[last];
+    map->_slots[map->_value_slots[last]].target = slot->target;
+  }
+
+  // Invalidate all handles to this slot and free it
+  slot->generation++;
+  slot->target = map->_free_head;
+  map->_free_head = handle.index;
+  return DYNARR_SUCCESS;
+}
+
+size_t slotmap_length(slotmap_t *map)
+{
+  return map->_length;
+}
+
+void slotmap_clear(slotmap_t *map)
+{
+  slotmap_cleanup_values(map);
+
+  // Free all slots in use
+  for (size_t i = 0; i < map->_length; i++)
+  {
+    slotmap_slot_t *slot = &map->_slots[map->_value_slots[i]];
+    slot->generation++;
+    slot->target = map->_free_head;
+    map->_free_head = map->_value_slots[i];
+  }
+
+  map->_length = 0;
+}
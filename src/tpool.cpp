@@ -0,0 +1,357 @@
+#include "blvckstd/tpool.h"
+
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <inttypes.h>
+
+// Worker the current thread runs, NULL for threads outside of any pool
+static __thread tpool_worker_t *tpool_self = NULL;
+
+/*
+============================================================================
+                                   Deque
+============================================================================
+*/
+
+/**
+ * @brief Get the slot of a deque position
+ */
+INLINED static volatile size_t *tpool_deque_slot(tpool_worker_t *worker, size_t pos)
+{
+  return &worker->tasks[pos & (TPOOL_DEQUE_CAP - 1)];
+}
+
+/**
+ * @brief Push a task onto the bottom of the worker's own deque
+ *
+ * @return true The task has been pushed
+ * @return false The deque is full
+ */
+static bool tpool_deque_push(tpool_worker_t *worker, tpool_task_t *task)
+{
+  size_t bottom = worker->_bottom;
+  size_t top = atomic_load_acquire(&worker->_top);
+  if ((intptr_t) (bottom - top) >= TPOOL_DEQUE_CAP) return false;
+
+  atomic_store_release(tpool_deque_slot(worker, bottom), (size_t) task);
+
+  // Publish the task to thieves
+  atomic_store_release(&worker->_bottom, bottom + 1);
+  return true;
+}
+
+/**
+ * @brief Pop a task off the bottom of the worker's own deque
+ *
+ * @return tpool_task_t* Task, NULL if the deque is empty
+ */
+static tpool_task_t *tpool_deque_pop(tpool_worker_t *worker)
+{
+  // Reserve the bottom task before looking at the top
+  size_t bottom = worker->_bottom - 1;
+  atomic_store_release(&worker->_bottom, bottom);
+  atomic_fence();
+  size_t top = atomic_load_acquire(&worker->_top);
+
+  // Deque has been empty
+  if ((intptr_t) (bottom - top) < 0)
+  {
+    atomic_store_release(&worker->_bottom, top);
+    return NULL;
+  }
+
+  tpool_task_t *task = (tpool_task_t *) atomic_load_acquire(tpool_deque_slot(worker, bottom));
+  if (bottom != top) return task;
+
+  // Last task, race thieves for it
+  if (!atomic_cas(&worker->_top, top, top + 1))
+    task = NULL;
+
+  atomic_store_release(&worker->_bottom, top + 1);
+  return task;
+}
+
+/**
+ * @brief Steal a task off the top of another worker's deque
+ *
+ * @return tpool_task_t* Task, NULL if the deque is empty or another thread won the race
+ */
+static tpool_task_t *tpool_deque_steal(tpool_worker_t *worker)
+{
+  size_t top = atomic_load_acquire(&worker->_top);
+  atomic_fence();
+  size_t bottom = atomic_load_acquire(&worker->_bottom);
+
+  if ((intptr_t) (bottom - top) <= 0) return NULL;
+
+  tpool_task_t *task = (tpool_task_t *) atomic_load_acquire(tpool_deque_slot(worker, top));
+  if (!atomic_cas(&worker->_top, top, top + 1)) return NULL;
+  return task;
+}
+
+/*
+============================================================================
+                                  Workers
+============================================================================
+*/
+
+/**
+ * @brief Run a task and release it
+ */
+static void tpool_run(tpool_task_t *task)
+{
+  task->fn(task->arg);
+  if (task->wg) tpool_wait_done(task->wg);
+  mman_dealloc(task);
+}
+
+/**
+ * @brief Find a pending task, preferring the own deque over outside submissions over stealing
+ *
+ * @param pool Pool reference
+ * @param self Worker of the calling thread, NULL if it's outside of the pool
+ * @return tpool_task_t* Task, NULL if nothing has been found
+ */
+static tpool_task_t *tpool_find_task(tpool_t *pool, tpool_worker_t *self)
+{
+  tpool_task_t *task = NULL;
+  if (self && (task = tpool_deque_pop(self))) return task;
+  if (mpmc_try_pop(pool->_inject, &task)) return task;
+
+  // Steal round robin, starting at the next worker to spread out thieves
+  size_t start = self ? self->_id + 1 : 0;
+  for (size_t i = 0; i < pool->_num_workers; i++)
+  {
+    tpool_worker_t *victim = pool->workers[(start + i) % pool->_num_workers];
+    if (victim != self && (task = tpool_deque_steal(victim))) return task;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Put an idle worker to sleep until it's woken up or the timeout passed
+ */
+static void tpool_sleep(tpool_t *pool)
+{
+  struct timespec until;
+  clock_gettime(CLOCK_REALTIME, &until);
+  until.tv_nsec += TPOOL_SLEEP_US * 1000;
+  until.tv_sec += until.tv_nsec / 1000000000;
+  until.tv_nsec %= 1000000000;
+
+  pthread_mutex_lock(&pool->_sleep_lock);
+  atomic_increment(&pool->_sleeping);
+  pthread_cond_timedwait(&pool->_sleep_cond, &pool->_sleep_lock, &until);
+  atomic_decrement(&pool->_sleeping);
+  pthread_mutex_unlock(&pool->_sleep_lock);
+}
+
+static void *tpool_worker_routine(void *arg)
+{
+  tpool_worker_t *worker = (tpool_worker_t *) arg;
+  tpool_t *pool = worker->_pool;
+  tpool_self = worker;
+
+  size_t idle = 0;
+  while (true)
+  {
+    tpool_task_t *task = tpool_find_task(pool, worker);
+    if (task)
+    {
+      tpool_run(task);
+      idle = 0;
+      continue;
+    }
+
+    // Only stop once there's nothing left to do
+    if (atomic_load_acquire(&pool->_stop)) break;
+
+    if (++idle < TPOOL_SPIN_LIMIT) sched_yield();
+    else tpool_sleep(pool);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Stop all workers of a no longer needed tpool struct and release them
+ */
+INLINED static void tpool_cleanup(mman_meta_t *ref)
+{
+  tpool_t *pool = (tpool_t *) ref->ptr;
+
+  atomic_store_release(&pool->_stop, 1);
+  pthread_mutex_lock(&pool->_sleep_lock);
+  pthread_cond_broadcast(&pool->_sleep_cond);
+  pthread_mutex_unlock(&pool->_sleep_lock);
+
+  for (size_t i = 0; i < pool->_num_workers; i++)
+  {
+    if (pool->workers[i]->_spawned)
+      pthread_join(pool->workers[i]->_thread, NULL);
+  }
+
+  // Run whatever has been left over by workers which couldn't be spawned
+  tpool_task_t *task;
+  while ((task = tpool_find_task(pool, NULL)))
+    tpool_run(task);
+
+  for (size_t i = 0; i < pool->_num_workers; i++)
+  {
+    mman_dealloc((void *) pool->workers[i]->tasks);
+    mman_dealloc(pool->workers[i]);
+  }
+
+  mman_dealloc(pool->workers);
+  mman_dealloc(pool->_inject);
+  pthread_cond_destroy(&pool->_sleep_cond);
+  pthread_mutex_destroy(&pool->_sleep_lock);
+}
+
+tpool_t *tpool_make(size_t num_threads)
+{
+  scptr tpool_t *res = (tpool_t *) mman_alloc(sizeof(tpool_t), 1, tpool_cleanup);
+
+  if (num_threads == 0)
+  {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    num_threads = online > 0 ? (size_t) online : 1;
+  }
+
+  res->_num_workers = num_threads; // no freeing
+  res->_stop = 0; // no freeing
+  res->_sleeping = 0; // no freeing
+  pthread_mutex_init(&res->_sleep_lock, NULL); // needs pthread freeing
+  pthread_cond_init(&res->_sleep_cond, NULL); // needs pthread freeing
+  res->_inject = mpmc_make(TPOOL_INJECT_CAP, sizeof(tpool_task_t *), NULL); // needs mman freeing
+
+  // All workers have to exist before any of them starts stealing
+  res->workers = (tpool_worker_t **) mman_alloc(sizeof(tpool_worker_t *), num_threads, NULL); // needs mman freeing
+  for (size_t i = 0; i < num_threads; i++)
+  {
+    tpool_worker_t *worker = (tpool_worker_t *) mman_alloc(sizeof(tpool_worker_t), 1, NULL); // needs mman freeing
+    worker->tasks = (volatile size_t *) mman_alloc(sizeof(size_t), TPOOL_DEQUE_CAP, NULL); // needs mman freeing
+    worker->_top = 0;
+    worker->_bottom = 0;
+    worker->_spawned = false;
+    worker->_pool = res;
+    worker->_id = i;
+    res->workers[i] = worker;
+  }
+
+  for (size_t i = 0; i < num_threads; i++)
+    res->workers[i]->_spawned = pthread_create(&res->workers[i]->_thread, NULL, tpool_worker_routine, res->workers[i]) == 0;
+
+  return (tpool_t *) mman_ref(res);
+}
+
+size_t tpool_num_threads(tpool_t *pool)
+{
+  return pool->_num_workers;
+}
+
+void tpool_submit(tpool_t *pool, tpool_task_f fn, void *arg, tpool_wait_t *wg)
+{
+  tpool_task_t *task = (tpool_task_t *) mman_alloc(sizeof(tpool_task_t), 1, NULL);
+  task->fn = fn;
+  task->arg = arg;
+  task->wg = wg;
+  if (wg) tpool_wait_add(wg, 1);
+
+  // Workers keep their own tasks, everybody else goes through the shared queue
+  tpool_worker_t *self = tpool_self && tpool_self->_pool == pool ? tpool_self : NULL;
+  bool queued = self ? tpool_deque_push(self, task) : mpmc_try_push(pool->_inject, &task);
+
+  // Out of space, run it right away instead
+  if (!queued)
+  {
+    tpool_run(task);
+    return;
+  }
+
+  if (atomic_load_acquire(&pool->_sleeping))
+  {
+    pthread_mutex_lock(&pool->_sleep_lock);
+    pthread_cond_signal(&pool->_sleep_cond);
+    pthread_mutex_unlock(&pool->_sleep_lock);
+  }
+}
+
+/**
+ * @brief Chunk of a parallel_for range
+ */
+typedef struct
+{
+  tpool_range_f fn;
+  void *arg;
+  size_t from;
+  size_t to;
+} tpool_chunk_t;
+
+static void tpool_chunk_routine(void *arg)
+{
+  tpool_chunk_t *chunk = (tpool_chunk_t *) arg;
+  chunk->fn(chunk->arg, chunk->from, chunk->to);
+}
+
+void tpool_parallel_for(tpool_t *pool, size_t from, size_t to, size_t grain, tpool_range_f fn, void *arg)
+{
+  if (from >= to) return;
+
+  size_t count = to - from;
+  if (grain == 0)
+    grain = u64_max(count / (pool->_num_workers * TPOOL_CHUNKS_PER_THREAD), 1);
+
+  size_t num_chunks = (count + grain - 1) / grain;
+  scptr tpool_chunk_t *chunks = (tpool_chunk_t *) mman_alloc(sizeof(tpool_chunk_t), num_chunks, NULL);
+
+  tpool_wait_t wg;
+  tpool_wait_init(&wg);
+
+  // The caller takes the first chunk itself
+  for (size_t i = 0; i < num_chunks; i++)
+  {
+    size_t chunk_from = from + i * grain;
+    chunks[i] = { fn, arg, chunk_from, u64_min(chunk_from + grain, to) };
+    if (i > 0) tpool_submit(pool, tpool_chunk_routine, &chunks[i], &wg);
+  }
+
+  tpool_chunk_routine(&chunks[0]);
+  tpool_wait(pool, &wg);
+}
+
+/*
+============================================================================
+                                Wait Groups
+============================================================================
+*/
+
+void tpool_wait_init(tpool_wait_t *wg)
+{
+  wg->_pending = 0;
+}
+
+void tpool_wait_add(tpool_wait_t *wg, size_t count)
+{
+  atomic_add(&wg->_pending, count);
+}
+
+void tpool_wait_done(tpool_wait_t *wg)
+{
+  atomic_decrement(&wg->_pending);
+}
+
+void tpool_wait(tpool_t *pool, tpool_wait_t *wg)
+{
+  tpool_worker_t *self = tpool_self && tpool_self->_pool == pool ? tpool_self : NULL;
+
+  // Help out instead of blocking, as the awaited tasks might sit in the own deque
+  while (atomic_load_acquire(&wg->_pending))
+  {
+    tpool_task_t *task = tpool_find_task(pool, self);
+    if (task) tpool_run(task);
+    else sched_yield();
+  }
+}
@@ -0,0 +1,158 @@
+#include "blvckstd/twheel.h"
+
+/**
+ * @brief Link a timer into the slot it's expiry falls into, relative to the current tick
+ */
+static void twheel_link(twheel_t *wheel, twheel_timer_t *timer)
+{
+  uint64_t delta = timer->_expires - wheel->_now;
+
+  // Find the lowest level covering the delta, the top level takes everything beyond
+  size_t level = 0;
+  while (level < TWHEEL_LEVELS - 1 && delta >> ((level + 1) * TWHEEL_SLOT_BITS))
+    level++;
+
+  // Out of range timers are parked at the farthest slot and relinked on it's turn
+  uint64_t expires = timer->_expires;
+  uint64_t range = (uint64_t) 1 << (TWHEEL_LEVELS * TWHEEL_SLOT_BITS);
+  if (delta >= range) expires = wheel->_now + range - 1;
+
+  twheel_timer_t **head = &wheel->slots[level][(expires >> (level * TWHEEL_SLOT_BITS)) & (TWHEEL_SLOTS - 1)];
+  timer->_next = *head;
+  timer->_pprev = head;
+  if (*head) (*head)->_pprev = &timer->_next;
+  *head = timer;
+}
+
+/**
+ * @brief Unlink a timer from it's slot
+ */
+INLINED static void twheel_unlink(twheel_timer_t *timer)
+{
+  *timer->_pprev = timer->_next;
+  if (timer->_next) timer->_next->_pprev = timer->_pprev;
+
+  timer->_next = NULL;
+  timer->_pprev = NULL;
+}
+
+/**
+ * @brief Relink all timers of a slot, moving them down the levels
+ */
+static void twheel_cascade(twheel_t *wheel, size_t level)
+{
+  twheel_timer_t **head = &wheel->slots[level][(wheel->_now >> (level * TWHEEL_SLOT_BITS)) & (TWHEEL_SLOTS - 1)];
+  twheel_timer_t *timer = *head;
+  *head = NULL;
+
+  while (timer)
+  {
+    twheel_timer_t *next = timer->_next;
+    twheel_link(wheel, timer);
+    timer = next;
+  }
+}
+
+/**
+ * @brief Clean up a no longer needed wheel, detaching all timers still pending
+ */
+INLINED static void twheel_cleanup(mman_meta_t *ref)
+{
+  twheel_t *wheel = (twheel_t *) ref->ptr;
+
+  // Timers are owned by the caller, they just must not point into the wheel anymore
+  for (size_t level = 0; level < TWHEEL_LEVELS; level++)
+  {
+    for (size_t slot = 0; slot < TWHEEL_SLOTS; slot++)
+    {
+      while (wheel->slots[level][slot])
+        twheel_unlink(wheel->slots[level][slot]);
+    }
+  }
+}
+
+twheel_t *twheel_make(uint64_t now)
+{
+  scptr twheel_t *res = (twheel_t *) mman_alloc(sizeof(twheel_t), 1, twheel_cleanup);
+
+  for (size_t level = 0; level < TWHEEL_LEVELS; level++)
+  {
+    for (size_t slot = 0; slot < TWHEEL_SLOTS; slot++)
+      res->slots[level][slot] = NULL; // no freeing
+  }
+
+  res->_now = now; // no freeing
+  res->_pending = 0; // no freeing
+
+  return (twheel_t *) mman_ref(res);
+}
+
+void twheel_timer_init(twheel_timer_t *timer, twheel_timer_f fn, void *arg)
+{
+  timer->fn = fn;
+  timer->arg = arg;
+  timer->_expires = 0;
+  timer->_next = NULL;
+  timer->_pprev = NULL;
+}
+
+void twheel_schedule(twheel_t *wheel, twheel_timer_t *timer, uint64_t delay)
+{
+  twheel_cancel(wheel, timer);
+
+  // The current tick has already been processed
+  timer->_expires = wheel->_now + (delay ? delay : 1);
+  twheel_link(wheel, timer);
+  wheel->_pending++;
+}
+
+bool twheel_cancel(twheel_t *wheel, twheel_timer_t *timer)
+{
+  if (!timer->_pprev) return false;
+
+  twheel_unlink(timer);
+  wheel->_pending--;
+  return true;
+}
+
+bool twheel_pending(twheel_timer_t *timer)
+{
+  return timer->_pprev != NULL;
+}
+
+size_t twheel_advance(twheel_t *wheel, uint64_t now)
+{
+  size_t fired = 0;
+
+  while (wheel->_now < now)
+  {
+    wheel->_now++;
+
+    // Once a level completed a turn, move the next slot of the level above down, top to bottom
+    size_t levels = 1;
+    while (levels < TWHEEL_LEVELS && !(wheel->_now & (((uint64_t) 1 << (levels * TWHEEL_SLOT_BITS)) - 1)))
+      levels++;
+
+    for (size_t level = levels - 1; level > 0; level--)
+      twheel_cascade(wheel, level);
+
+    // Fire one at a time, as routines may cancel other timers of the same slot
+    twheel_timer_t **head = &wheel->slots[0][wheel->_now & (TWHEEL_SLOTS - 1)];
+    while (*head)
+    {
+      twheel_timer_t *timer = *head;
+      twheel_unlink(timer);
+      wheel->_pending--;
+      fired++;
+
+      timer->fn(timer->arg);
+    }
+  }
+
+  return fired;
+}
+
+size_t twheel_length(twheel_t *wheel)
+{
+  return wheel->_pending;
+}
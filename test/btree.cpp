@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <blvckstd/btree.h>
+#include <blvckstd/strfmt.h>
+
+#define EXIT_TEST_FAILURE(varname, retv)                              \
+  {                                                                   \
+    const char *rets = btree_result_name(retv);                       \
+    printf(varname " didn't match the expected value! (%s)\n", rets); \
+    return 1;                                                         \
+  }
+
+#define TEST_KEYS 5000
+
+/**
+ * @brief Count the remaining items of an iterator, checking their order
+ */
+static int count_ordered(btree_iter_t *iter)
+{
+  const char *prev = NULL, *key = NULL;
+  int count = 0;
+
+  while (btree_iter_next(iter, &key, NULL))
+  {
+    if (prev && strcmp(prev, key) >= 0) return -1;
+    prev = key;
+    count++;
+  }
+
+  return count;
+}
+
+int test_insert_remove()
+{
+  scptr btree_t *tree = btree_make(mman_dealloc_nr);
+
+  // Insert in a scattered order, values equal to their keys
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%05d", (i * 7919) % TEST_KEYS);
+    btree_result_t ret = btree_insert(tree, key, mman_ref(key));
+    if (ret != BTREE_SUCCESS)
+      EXIT_TEST_FAILURE("insert", ret);
+  }
+
+  btree_result_t dup_ret = btree_insert(tree, "key-00042", (void *) "dup");
+  if (dup_ret != BTREE_KEY_ALREADY_EXISTS)
+    EXIT_TEST_FAILURE("insert duplicate", dup_ret);
+
+  btree_iter_t iter;
+  btree_first(tree, &iter);
+  if (count_ordered(&iter) != TEST_KEYS)
+    EXIT_TEST_FAILURE("ordered iteration", BTREE_SUCCESS);
+
+  // Remove every odd key, which forces borrowing and merging
+  for (int i = 1; i < TEST_KEYS; i += 2)
+  {
+    scptr char *key = strfmt_direct("key-%05d", i);
+    btree_result_t ret = btree_remove(tree, key);
+    if (ret != BTREE_SUCCESS)
+      EXIT_TEST_FAILURE("remove", ret);
+  }
+
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%05d", i);
+    char *value = NULL;
+    btree_result_t ret = btree_fetch(tree, key, (void **) &value);
+
+    if (i % 2 == 0 && (ret != BTREE_SUCCESS || strcmp(key, value) != 0))
+      EXIT_TEST_FAILURE("fetch", ret);
+
+    if (i % 2 == 1 && ret != BTREE_KEY_NOT_FOUND)
+      EXIT_TEST_FAILURE("fetch removed", ret);
+  }
+
+  btree_first(tree, &iter);
+  if (btree_count(tree) != TEST_KEYS / 2 || count_ordered(&iter) != TEST_KEYS / 2)
+    EXIT_TEST_FAILURE("count after removal", BTREE_SUCCESS);
+
+  // Drain completely
+  for (int i = 0; i < TEST_KEYS; i += 2)
+  {
+    scptr char *key = strfmt_direct("key-%05d", i);
+    btree_result_t ret = btree_remove(tree, key);
+    if (ret != BTREE_SUCCESS)
+      EXIT_TEST_FAILURE("drain", ret);
+  }
+
+  btree_first(tree, &iter);
+  if (btree_count(tree) != 0 || !tree->root->_leaf || btree_iter_next(&iter, NULL, NULL))
+    EXIT_TEST_FAILURE("empty", BTREE_SUCCESS);
+
+  return 0;
+}
+
+int test_ranges()
+{
+  scptr btree_t *tree = btree_make(NULL);
+  for (int i = 0; i < TEST_KEYS; i += 2)
+  {
+    scptr char *key = strfmt_direct("key-%05d", i);
+    btree_insert(tree, key, (void *) tree);
+  }
+
+  btree_iter_t iter;
+  const char *key = NULL;
+
+  // Bounds on existing and missing keys
+  btree_lower_bound(tree, "key-00100", &iter);
+  if (!btree_iter_next(&iter, &key, NULL) || strcmp(key, "key-00100") != 0)
+    EXIT_TEST_FAILURE("lower bound hit", BTREE_SUCCESS);
+
+  btree_upper_bound(tree, "key-00100", &iter);
+  if (!btree_iter_next(&iter, &key, NULL) || strcmp(key, "key-00102") != 0)
+    EXIT_TEST_FAILURE("upper bound hit", BTREE_SUCCESS);
+
+  btree_lower_bound(tree, "key-00101", &iter);
+  if (!btree_iter_next(&iter, &key, NULL) || strcmp(key, "key-00102") != 0)
+    EXIT_TEST_FAILURE("lower bound miss", BTREE_SUCCESS);
+
+  btree_lower_bound(tree, "zzz", &iter);
+  if (btree_iter_next(&iter, &key, NULL))
+    EXIT_TEST_FAILURE("lower bound past end", BTREE_SUCCESS);
+
+  // [key-01000, key-02000) holds 500 even keys
+  btree_range(tree, "key-01000", "key-02000", &iter);
+  if (count_ordered(&iter) != 500)
+    EXIT_TEST_FAILURE("range", BTREE_SUCCESS);
+
+  btree_range(tree, NULL, "key-00010", &iter);
+  if (count_ordered(&iter) != 5)
+    EXIT_TEST_FAILURE("open range", BTREE_SUCCESS);
+
+  // key-012xx holds 50 even keys
+  btree_prefix(tree, "key-012", &iter);
+  if (count_ordered(&iter) != 50)
+    EXIT_TEST_FAILURE("prefix", BTREE_SUCCESS);
+
+  return 0;
+}
+
+int proc()
+{
+  int ret;
+  if ((ret = test_insert_remove()) != 0) return ret;
+  if ((ret = test_ranges()) != 0) return ret;
+  return 0;
+}
+
+int main()
+{
+  int ret = proc();
+
+  if (ret == 0)
+    printf("Tests passed!\n");
+  else
+    printf("Test(s) failed!\n");
+
+  mman_print_info();
+  return ret;
+}
@@ -0,0 +1,662 @@
+#include <stdio.h>
+#include <blvckstd/dynarr.h>
+#include <blvckstd/dynvec.h>
+#include <blvckstd/dynseg.h>
+#include <blvckstd/slotmap.h>
+#include <blvckstd/dynarr_par.h>
+
+#define EXIT_TEST_FAILURE(varname, retv)                              \
+  {                                                                   \
+    const char *rets = dynarr_result_name(retv);                      \
+    printf(varname " didn't match the expected value! (%s)\n", rets); \
+    return 1;                                                         \
+  }
+
+#define TEST_ITEMS 100000
+
+/**
+ * @brief Get a non-NULL dummy item for an index
+ */
+static void *test_item(size_t i)
+{
+  return (void *) (i + 1);
+}
+
+int test_push()
+{
+  scptr dynarr_t *arr = dynarr_make(16, TEST_ITEMS, NULL);
+
+  // Appending grows the array up to it's cap
+  for (size_t i = 0; i < TEST_ITEMS; i++)
+  {
+    size_t slot;
+    dynarr_result_t ret = dynarr_push(arr, test_item(i), &slot);
+    if (ret != DYNARR_SUCCESS || slot != i)
+      EXIT_TEST_FAILURE("push", ret);
+  }
+
+  dynarr_result_t full_ret = dynarr_push(arr, test_item(0), NULL);
+  if (full_ret != DYNARR_FULL)
+    EXIT_TEST_FAILURE("push full", full_ret);
+
+  // Holes are filled lowest first
+  dynarr_remove_at(arr, 70000, NULL);
+  dynarr_remove_at(arr, 5, NULL);
+  dynarr_remove_at(arr, 130, NULL);
+
+  size_t expected[] = { 5, 130, 70000 };
+  for (size_t i = 0; i < 3; i++)
+  {
+    size_t slot;
+    dynarr_result_t ret = dynarr_push(arr, test_item(i), &slot);
+    if (ret != DYNARR_SUCCESS || slot != expected[i])
+      EXIT_TEST_FAILURE("push into hole", ret);
+  }
+
+  // Counting and listing only sees occupied slots
+  dynarr_remove_at(arr, 64, NULL);
+  dynarr_remove_at(arr, 99999, NULL);
+
+  size_t *indices = NULL, num_indices = 0;
+  dynarr_indices(arr, &indices, &num_indices);
+  bool indices_match = num_indices == TEST_ITEMS - 2 && indices[63] == 63 && indices[64] == 65 && indices[num_indices - 1] == 99998;
+  mman_dealloc(indices);
+
+  if (dynarr_length(arr) != TEST_ITEMS - 2 || !indices_match)
+    EXIT_TEST_FAILURE("indices", DYNARR_SUCCESS);
+
+  scptr void **items = NULL;
+  if (dynarr_as_array(arr, &items) != TEST_ITEMS - 2 || items[64] != test_item(65) || items[TEST_ITEMS - 2] != NULL)
+    EXIT_TEST_FAILURE("as array", DYNARR_SUCCESS);
+
+  // Iteration visits the same slots in place
+  size_t num_visited = 0;
+  DYNARR_FOREACH(arr, it)
+  {
+    if (it.item != arr->items[it.index] || (num_visited == 64 && it.index != 65))
+      EXIT_TEST_FAILURE("foreach", DYNARR_SUCCESS);
+    num_visited++;
+  }
+
+  if (num_visited != TEST_ITEMS - 2)
+    EXIT_TEST_FAILURE("foreach count", DYNARR_SUCCESS);
+
+  dynarr_push(arr, test_item(64), NULL);
+  dynarr_push(arr, test_item(99999), NULL);
+
+  // Setting NULL frees a slot as well
+  dynarr_set_at(arr, 42, NULL);
+  size_t slot;
+  dynarr_push(arr, test_item(42), &slot);
+  if (slot != 42)
+    EXIT_TEST_FAILURE("push into cleared slot", DYNARR_SUCCESS);
+
+  return 0;
+}
+
+int test_dense()
+{
+  scptr dynarr_t *arr = dynarr_make_dense(4, 64, NULL);
+
+  for (size_t i = 0; i < 10; i++)
+    dynarr_push(arr, test_item(i), NULL);
+
+  dynarr_result_t null_ret = dynarr_push(arr, NULL, NULL);
+  if (null_ret != DYNARR_NULL_ITEM || dynarr_length(arr) != 10)
+    EXIT_TEST_FAILURE("dense push", null_ret);
+
+  // Removal keeps the order, the gap is closed
+  void *removed = NULL;
+  dynarr_result_t ret = dynarr_remove_at(arr, 3, &removed);
+  if (ret != DYNARR_SUCCESS || removed != test_item(3) || dynarr_length(arr) != 9)
+    EXIT_TEST_FAILURE("dense remove", ret);
+
+  for (size_t i = 0; i < 9; i++)
+    if (arr->items[i] != test_item(i < 3 ? i : i + 1))
+      EXIT_TEST_FAILURE("dense order", DYNARR_SUCCESS);
+
+  if (arr->items[9] != NULL || dynarr_remove_at(arr, 9, NULL) != DYNARR_INDEX_NOT_FOUND)
+    EXIT_TEST_FAILURE("dense tail", DYNARR_SUCCESS);
+
+  // Pushing appends behind the last item
+  size_t slot;
+  dynarr_push(arr, test_item(3), &slot);
+  if (slot != 9)
+    EXIT_TEST_FAILURE("dense append", DYNARR_SUCCESS);
+
+  // Popping drains from the back
+  for (size_t i = 10; i-- > 0;)
+  {
+    void *last = arr->items[i];
+    ret = dynarr_pop(arr, &removed);
+    if (ret != DYNARR_SUCCESS || removed != last || dynarr_length(arr) != i)
+      EXIT_TEST_FAILURE("dense pop", ret);
+  }
+
+  ret = dynarr_pop(arr, NULL);
+  if (ret != DYNARR_EMPTY)
+    EXIT_TEST_FAILURE("dense pop empty", ret);
+
+  // Sparse arrays pop their highest occupied slot
+  scptr dynarr_t *sparse = dynarr_make(128, 128, NULL);
+  dynarr_set_at(sparse, 3, test_item(3));
+  dynarr_set_at(sparse, 100, test_item(100));
+
+  ret = dynarr_pop(sparse, &removed);
+  if (ret != DYNARR_SUCCESS || removed != test_item(100))
+    EXIT_TEST_FAILURE("sparse pop", ret);
+
+  return 0;
+}
+
+typedef struct
+{
+  int x, y;
+} test_point_t;
+
+int test_dynvec()
+{
+  scptr dynvec_t *nums = DYNVEC_MAKE(int, 0, TEST_ITEMS, NULL);
+  for (int i = 0; i < TEST_ITEMS; i++)
+  {
+    dynarr_result_t ret = dynvec_push_val<int>(nums, i * 2);
+    if (ret != DYNARR_SUCCESS)
+      EXIT_TEST_FAILURE("dynvec push", ret);
+  }
+
+  // Elements are stored inline, back to back
+  long sum = 0;
+  for (size_t i = 0; i < dynvec_length(nums); i++)
+    sum += DYNVEC_AT(nums, int, i);
+
+  if (sum != (long) TEST_ITEMS * (TEST_ITEMS - 1))
+    EXIT_TEST_FAILURE("dynvec sum", DYNARR_SUCCESS);
+
+  int removed = 0;
+  dynarr_result_t ret = dynvec_remove_at(nums, 1, &removed);
+  if (ret != DYNARR_SUCCESS || removed != 2 || DYNVEC_AT(nums, int, 1) != 4)
+    EXIT_TEST_FAILURE("dynvec remove", ret);
+
+  scptr dynvec_t *points = DYNVEC_MAKE(test_point_t, 2, 2, NULL);
+  dynvec_push_val<test_point_t>(points, { 1, 2 });
+  dynvec_push_val<test_point_t>(points, { 3, 4 });
+
+  ret = dynvec_push_val<test_point_t>(points, { 5, 6 });
+  if (ret != DYNARR_FULL)
+    EXIT_TEST_FAILURE("dynvec full", ret);
+
+  dynvec_set_val<test_point_t>(points, 0, { 7, 8 });
+  test_point_t popped;
+  ret = dynvec_pop(points, &popped);
+  if (
+    ret != DYNARR_SUCCESS || popped.x != 3 || dynvec_length(points) != 1
+    || ((test_point_t *) dynvec_at(points, 0))->y != 8 || dynvec_at(points, 1) != NULL
+  )
+    EXIT_TEST_FAILURE("dynvec structs", ret);
+
+  // Values get converted to the element type, which has to match it's size
+  scptr dynvec_t *doubles = DYNVEC_MAKE(double, 2, 2, NULL);
+  dynvec_push_val<double>(doubles, 1);
+  dynvec_push_val<double>(doubles, 2.5f);
+
+  double value = 0;
+  ret = dynvec_get_val(doubles, 1, &value);
+  if (ret != DYNARR_SUCCESS || value != 2.5 || DYNVEC_AT(doubles, double, 0) != 1)
+    EXIT_TEST_FAILURE("dynvec typed get", ret);
+
+  int narrow = 0;
+  if ((ret = dynvec_set_val<int>(doubles, 0, 3)) != DYNARR_SIZE_MISMATCH)
+    EXIT_TEST_FAILURE("dynvec typed set", ret);
+
+  if ((ret = dynvec_get_val(doubles, 0, &narrow)) != DYNARR_SIZE_MISMATCH)
+    EXIT_TEST_FAILURE("dynvec typed mismatch", ret);
+
+  return 0;
+}
+
+static size_t test_grow_to_square(size_t array_size, size_t min_size)
+{
+  return min_size * min_size;
+}
+
+int test_inline()
+{
+  scptr dynarr_t *arr = dynarr_make(DYNARR_INLINE_SLOTS, 100, NULL);
+  if (arr->items != arr->_inline_items)
+    EXIT_TEST_FAILURE("inline make", DYNARR_SUCCESS);
+
+  for (size_t i = 0; i < DYNARR_INLINE_SLOTS; i++)
+    dynarr_push(arr, test_item(i), NULL);
+
+  if (arr->items != arr->_inline_items)
+    EXIT_TEST_FAILURE("inline push", DYNARR_SUCCESS);
+
+  // Growing past the inline slots moves to the heap, keeping items and occupancy
+  dynarr_remove_at(arr, 1, NULL);
+  dynarr_push(arr, test_item(DYNARR_INLINE_SLOTS), NULL);
+  dynarr_push(arr, test_item(DYNARR_INLINE_SLOTS + 1), NULL);
+  if (arr->items == arr->_inline_items || arr->items[1] != test_item(DYNARR_INLINE_SLOTS) || dynarr_length(arr) != DYNARR_INLINE_SLOTS + 1)
+    EXIT_TEST_FAILURE("inline grow", DYNARR_SUCCESS);
+
+  // Shrinking back down moves inline again
+  dynarr_remove_at(arr, DYNARR_INLINE_SLOTS, NULL);
+  dynarr_shrink_to_fit(arr);
+  if (arr->items != arr->_inline_items || arr->_array_size != DYNARR_INLINE_SLOTS || dynarr_length(arr) != DYNARR_INLINE_SLOTS)
+    EXIT_TEST_FAILURE("inline shrink", DYNARR_SUCCESS);
+
+  size_t slot;
+  if (dynarr_push(arr, test_item(0), &slot) != DYNARR_SUCCESS || slot != DYNARR_INLINE_SLOTS)
+    EXIT_TEST_FAILURE("inline regrow", DYNARR_SUCCESS);
+
+  return 0;
+}
+
+int test_sizing()
+{
+  scptr dynarr_t *arr = dynarr_make(0, 1000, NULL);
+
+  // Fixed chunks
+  dynarr_grow_by_chunk(arr, 10);
+  dynarr_push(arr, test_item(0), NULL);
+  if (arr->_array_size != 10)
+    EXIT_TEST_FAILURE("chunk growth", DYNARR_SUCCESS);
+
+  // Custom callbacks, constrained by the cap
+  dynarr_grow_custom(arr, test_grow_to_square);
+  for (size_t i = 1; i <= 10; i++)
+    dynarr_push(arr, test_item(i), NULL);
+
+  if (arr->_array_size != 121)
+    EXIT_TEST_FAILURE("custom growth", DYNARR_SUCCESS);
+
+  // Exact pre-sizing
+  dynarr_result_t ret = dynarr_reserve(arr, 500);
+  if (ret != DYNARR_SUCCESS || arr->_array_size != 500)
+    EXIT_TEST_FAILURE("reserve", ret);
+
+  ret = dynarr_reserve(arr, 1001);
+  if (ret != DYNARR_FULL)
+    EXIT_TEST_FAILURE("reserve past cap", ret);
+
+  // Shrinking keeps all slots up to the highest active one
+  dynarr_set_at(arr, 130, test_item(130));
+  dynarr_shrink_to_fit(arr);
+  if (arr->_array_size != 131 || dynarr_length(arr) != 12)
+    EXIT_TEST_FAILURE("shrink to fit", DYNARR_SUCCESS);
+
+  // Factor growth, from the 11 slots left after shrinking
+  dynarr_grow_by_factor(arr, 1.5);
+  dynarr_set_at(arr, 130, NULL);
+  dynarr_shrink_to_fit(arr);
+
+  size_t slot;
+  dynarr_push(arr, test_item(11), &slot);
+
+  if (arr->_array_size != 16 || slot != 11)
+    EXIT_TEST_FAILURE("factor growth", DYNARR_SUCCESS);
+
+  // Deferred allocation, taking over the policy once the requested size is used up
+  dynarr_growth_t growth;
+  growth.mode = DYNARR_GM_CHUNK;
+  growth.chunk = 8;
+
+  scptr dynarr_t *deferred = dynarr_make_ex(20, 100, NULL, growth);
+  if (deferred->_array_size != 0 || deferred->items != deferred->_inline_items)
+    EXIT_TEST_FAILURE("deferred make", DYNARR_SUCCESS);
+
+  dynarr_push(deferred, test_item(0), NULL);
+  if (deferred->_array_size != 20)
+    EXIT_TEST_FAILURE("deferred push", DYNARR_SUCCESS);
+
+  for (size_t i = 1; i <= 20; i++)
+    dynarr_push(deferred, test_item(i), NULL);
+
+  if (deferred->_array_size != 28 || dynarr_length(deferred) != 21)
+    EXIT_TEST_FAILURE("deferred growth", DYNARR_SUCCESS);
+
+  return 0;
+}
+
+static int test_cmp_items(const void *a, const void *b)
+{
+  return (uintptr_t) a < (uintptr_t) b ? -1 : (uintptr_t) a > (uintptr_t) b;
+}
+
+static uint64_t test_item_key(const void *item)
+{
+  return (uintptr_t) item;
+}
+
+static const char *test_item_str(const void *item)
+{
+  return (const char *) item;
+}
+
+/**
+ * @brief Fill an array with pseudo-random items, leaving every seventh slot empty
+ */
+static void test_fill_random(dynarr_t *arr, size_t n)
+{
+  uint64_t state = 42;
+  for (size_t i = 0; i < n; i++)
+  {
+    state = state * 6364136223846793005UL + 1442695040888963407UL;
+    dynarr_set_at(arr, i, i % 7 == 0 ? NULL : test_item(state >> 40));
+  }
+}
+
+/**
+ * @brief Check that the first n slots are sorted and all following slots are empty
+ */
+static bool test_is_sorted(dynarr_t *arr, size_t n)
+{
+  for (size_t i = 1; i < n; i++)
+    if (test_cmp_items(arr->items[i - 1], arr->items[i]) > 0) return false;
+
+  for (size_t i = n; i < arr->_array_size; i++)
+    if (arr->items[i]) return false;
+
+  return dynarr_length(arr) == n;
+}
+
+int test_sort()
+{
+  size_t n = TEST_ITEMS - (TEST_ITEMS + 6) / 7;
+  scptr dynarr_t *arr = dynarr_make(TEST_ITEMS, TEST_ITEMS, NULL);
+
+  // Holes end up behind the sorted items
+  test_fill_random(arr, TEST_ITEMS);
+  dynarr_sort(arr, test_cmp_items);
+  if (!test_is_sorted(arr, n))
+    EXIT_TEST_FAILURE("sort", DYNARR_SUCCESS);
+
+  // Pushing continues behind the packed items
+  size_t slot;
+  dynarr_push(arr, test_item(0), &slot);
+  dynarr_remove_at(arr, slot, NULL);
+  if (slot != n)
+    EXIT_TEST_FAILURE("push after sort", DYNARR_SUCCESS);
+
+  size_t index;
+  void *key = arr->items[1234];
+  dynarr_result_t ret = dynarr_bsearch(arr, key, test_cmp_items, &index);
+  if (ret != DYNARR_SUCCESS || arr->items[index] != key || (index > 0 && arr->items[index - 1] == key))
+    EXIT_TEST_FAILURE("bsearch", ret);
+
+  ret = dynarr_bsearch(arr, (void *) UINTPTR_MAX, test_cmp_items, &index);
+  if (ret != DYNARR_INDEX_NOT_FOUND || index != n)
+    EXIT_TEST_FAILURE("bsearch miss", ret);
+
+  test_fill_random(arr, TEST_ITEMS);
+  dynarr_sort_radix(arr, test_item_key);
+  if (!test_is_sorted(arr, n))
+    EXIT_TEST_FAILURE("radix sort", DYNARR_SUCCESS);
+
+  scptr tpool_t *pool = tpool_make(4);
+  test_fill_random(arr, TEST_ITEMS);
+  dynarr_sort_parallel(arr, test_cmp_items, pool);
+  if (!test_is_sorted(arr, n))
+    EXIT_TEST_FAILURE("parallel sort", DYNARR_SUCCESS);
+
+  // String keys, including shared prefixes and duplicates
+  const char *strs[] = { "b", "abc", "", "ab", "abd", "b", "a", "abcd", "ba", "aa" };
+  const char *sorted[] = { "", "a", "aa", "ab", "abc", "abcd", "abd", "b", "b", "ba" };
+  scptr dynarr_t *str_arr = dynarr_make_dense(10, 10, NULL);
+  for (size_t i = 0; i < 10; i++)
+    dynarr_push(str_arr, (void *) strs[i], NULL);
+
+  dynarr_sort_radix_str(str_arr, test_item_str);
+  for (size_t i = 0; i < 10; i++)
+    if (strcmp((char *) str_arr->items[i], sorted[i]) != 0)
+      EXIT_TEST_FAILURE("radix string sort", DYNARR_SUCCESS);
+
+  return 0;
+}
+
+int test_dynseg()
+{
+  scptr dynseg_t *arr = dynseg_make(100, TEST_ITEMS, NULL);
+  if (arr->_chunk_shift != 7)
+    EXIT_TEST_FAILURE("dynseg chunk size", DYNARR_SUCCESS);
+
+  dynseg_push(arr, test_item(0), NULL);
+  void **first = dynseg_slot(arr, 0);
+
+  for (size_t i = 1; i < TEST_ITEMS; i++)
+  {
+    size_t slot;
+    dynarr_result_t ret = dynseg_push(arr, test_item(i), &slot);
+    if (ret != DYNARR_SUCCESS || slot != i)
+      EXIT_TEST_FAILURE("dynseg push", ret);
+  }
+
+  dynarr_result_t ret = dynseg_push(arr, test_item(0), NULL);
+  if (ret != DYNARR_FULL)
+    EXIT_TEST_FAILURE("dynseg full", ret);
+
+  // Growing never moved the first slot
+  if (dynseg_slot(arr, 0) != first || *first != test_item(0))
+    EXIT_TEST_FAILURE("dynseg stable address", DYNARR_SUCCESS);
+
+  for (size_t i = 0; i < TEST_ITEMS; i++)
+    if (dynseg_get(arr, i) != test_item(i))
+      EXIT_TEST_FAILURE("dynseg get", DYNARR_SUCCESS);
+
+  void *removed;
+  ret = dynseg_remove_at(arr, 500, &removed);
+  if (ret != DYNARR_SUCCESS || removed != test_item(500) || dynseg_length(arr) != TEST_ITEMS - 1 || dynseg_get(arr, 500))
+    EXIT_TEST_FAILURE("dynseg remove", ret);
+
+  if (dynseg_get(arr, TEST_ITEMS) || dynseg_set_at(arr, TEST_ITEMS, test_item(0)) != DYNARR_INDEX_NOT_FOUND)
+    EXIT_TEST_FAILURE("dynseg range", DYNARR_SUCCESS);
+
+  // Holes get filled, lowest first, so a full array keeps accepting items under churn
+  size_t slot;
+  dynseg_remove_at(arr, 900, NULL);
+  for (size_t i = 0; i < TEST_ITEMS; i++)
+  {
+    ret = dynseg_push(arr, test_item(i), &slot);
+    if (ret != DYNARR_SUCCESS || slot != 500)
+      EXIT_TEST_FAILURE("dynseg reuse", ret);
+
+    dynseg_remove_at(arr, slot, NULL);
+  }
+
+  dynseg_push(arr, test_item(500), NULL);
+  if (dynseg_push(arr, test_item(900), &slot) != DYNARR_SUCCESS || slot != 900 || arr->_array_size != TEST_ITEMS)
+    EXIT_TEST_FAILURE("dynseg reuse size", DYNARR_SUCCESS);
+
+  return 0;
+}
+
+int test_slotmap()
+{
+  scptr slotmap_t *map = slotmap_make(4, TEST_ITEMS, NULL);
+  scptr slotmap_handle_t *handles = (slotmap_handle_t *) mman_alloc(sizeof(slotmap_handle_t), TEST_ITEMS, NULL);
+
+  for (size_t i = 0; i < TEST_ITEMS; i++)
+  {
+    dynarr_result_t ret = slotmap_insert(map, test_item(i), &handles[i]);
+    if (ret != DYNARR_SUCCESS)
+      EXIT_TEST_FAILURE("slotmap insert", ret);
+  }
+
+  dynarr_result_t ret = slotmap_insert(map, test_item(0), &handles[0]);
+  if (ret != DYNARR_FULL)
+    EXIT_TEST_FAILURE("slotmap full", ret);
+
+  // Remove every third item
+  for (size_t i = 0; i < TEST_ITEMS; i += 3)
+  {
+    void *removed;
+    ret = slotmap_remove(map, handles[i], &removed);
+    if (ret != DYNARR_SUCCESS || removed != test_item(i))
+      EXIT_TEST_FAILURE("slotmap remove", ret);
+  }
+
+  // Reuse the freed slots, stale handles have to miss
+  slotmap_handle_t reused;
+  for (size_t i = 0; i < TEST_ITEMS; i += 3)
+  {
+    ret = slotmap_insert(map, test_item(TEST_ITEMS + i), &reused);
+    if (ret != DYNARR_SUCCESS)
+      EXIT_TEST_FAILURE("slotmap reinsert", ret);
+  }
+
+  if (slotmap_length(map) != TEST_ITEMS || reused.generation != 1)
+    EXIT_TEST_FAILURE("slotmap length", DYNARR_SUCCESS);
+
+  for (size_t i = 0; i < TEST_ITEMS; i++)
+  {
+    void *item = slotmap_get(map, handles[i]);
+    if (i % 3 == 0 ? item != NULL : item != test_item(i))
+      EXIT_TEST_FAILURE("slotmap get", DYNARR_SUCCESS);
+  }
+
+  ret = slotmap_remove(map, handles[0], NULL);
+  if (ret != DYNARR_INDEX_NOT_FOUND)
+    EXIT_TEST_FAILURE("slotmap stale remove", ret);
+
+  // Values stay densely packed
+  for (size_t i = 0; i < slotmap_length(map); i++)
+    if (!map->values[i])
+      EXIT_TEST_FAILURE("slotmap values", DYNARR_SUCCESS);
+
+  slotmap_clear(map);
+  if (slotmap_length(map) != 0 || slotmap_get(map, reused))
+    EXIT_TEST_FAILURE("slotmap clear", DYNARR_SUCCESS);
+
+  // A cap below the initial size still holds the one slot that's always allocated
+  scptr slotmap_t *tiny = slotmap_make(4, 0, NULL);
+  slotmap_handle_t tiny_handle;
+  ret = slotmap_insert(tiny, test_item(1), &tiny_handle);
+  if (ret != DYNARR_SUCCESS)
+    EXIT_TEST_FAILURE("slotmap tiny insert", ret);
+
+  ret = slotmap_insert(tiny, test_item(2), &tiny_handle);
+  if (ret != DYNARR_FULL || tiny->_array_size != 1)
+    EXIT_TEST_FAILURE("slotmap tiny full", ret);
+
+  return 0;
+}
+
+static void *test_double(void *item, void *arg)
+{
+  size_t *res = (size_t *) mman_alloc(sizeof(size_t), 1, NULL);
+  *res = (size_t) item * 2;
+  return res;
+}
+
+static bool test_is_even(void *item, void *arg)
+{
+  return (size_t) item % 2 == 0;
+}
+
+static void *test_make_sum(void *arg)
+{
+  return mman_calloc(sizeof(size_t), 1, NULL);
+}
+
+// Accumulates in place
+static void *test_sum(void *acc, void *item, void *arg)
+{
+  *(size_t *) acc += (size_t) item;
+  return acc;
+}
+
+static void *test_combine_sums(void *acc, void *other, void *arg)
+{
+  *(size_t *) acc += *(size_t *) other;
+  mman_dealloc(other);
+  return acc;
+}
+
+int test_parallel()
+{
+  scptr tpool_t *pool = tpool_make(4);
+  scptr dynarr_t *arr = dynarr_make(16, TEST_ITEMS, NULL);
+
+  for (size_t i = 0; i < TEST_ITEMS; i++)
+    dynarr_push(arr, test_item(i), NULL);
+
+  // Leave holes at every seventh slot
+  size_t expected_sum = 0, expected_count = 0;
+  for (size_t i = 0; i < TEST_ITEMS; i++)
+  {
+    if (i % 7 == 0) dynarr_remove_at(arr, i, NULL);
+    else
+    {
+      expected_sum += i + 1;
+      expected_count++;
+    }
+  }
+
+  scptr dynarr_t *mapped = dynarr_par_map(arr, pool, test_double, NULL, mman_dealloc_nr);
+  if (dynarr_length(mapped) != expected_count)
+    EXIT_TEST_FAILURE("par_map length", DYNARR_SUCCESS);
+
+  // Results keep the order of their items
+  size_t prev = 0;
+  DYNARR_FOREACH(mapped, it)
+  {
+    size_t value = *(size_t *) it.item;
+    if (value <= prev || value % 2 != 0)
+      EXIT_TEST_FAILURE("par_map order", DYNARR_SUCCESS);
+    prev = value;
+  }
+
+  scptr dynarr_t *filtered = dynarr_par_filter(arr, pool, test_is_even, NULL);
+  prev = 0;
+  size_t filtered_count = 0;
+  DYNARR_FOREACH(filtered, it)
+  {
+    if ((size_t) it.item <= prev || (size_t) it.item % 2 != 0)
+      EXIT_TEST_FAILURE("par_filter order", DYNARR_SUCCESS);
+    prev = (size_t) it.item;
+    filtered_count++;
+  }
+
+  if (filtered_count != dynarr_length(filtered) || filtered_count == 0)
+    EXIT_TEST_FAILURE("par_filter length", DYNARR_SUCCESS);
+
+  scptr size_t *sum = (size_t *) dynarr_par_reduce(arr, pool, test_make_sum, test_sum, test_combine_sums, NULL);
+  if (*sum != expected_sum)
+    EXIT_TEST_FAILURE("par_reduce", DYNARR_SUCCESS);
+
+  // Empty arrays yield empty results
+  scptr dynarr_t *empty = dynarr_make(0, 10, NULL);
+  scptr dynarr_t *empty_mapped = dynarr_par_map(empty, pool, test_double, NULL, mman_dealloc_nr);
+  scptr size_t *empty_sum = (size_t *) dynarr_par_reduce(empty, pool, test_make_sum, test_sum, test_combine_sums, NULL);
+  if (dynarr_length(empty_mapped) != 0 || *empty_sum != 0)
+    EXIT_TEST_FAILURE("par empty", DYNARR_SUCCESS);
+
+  return 0;
+}
+
+int proc()
+{
+  int ret;
+  if ((ret = test_push()) != 0) return ret;
+  if ((ret = test_dense()) != 0) return ret;
+  if ((ret = test_dynvec()) != 0) return ret;
+  if ((ret = test_inline()) != 0) return ret;
+  if ((ret = test_sizing()) != 0) return ret;
+  if ((ret = test_sort()) != 0) return ret;
+  if ((ret = test_dynseg()) != 0) return ret;
+  if ((ret = test_slotmap()) != 0) return ret;
+  if ((ret = test_parallel()) != 0) return ret;
+  return 0;
+}
+
+int main()
+{
+  int ret = proc();
+
+  if (ret == 0)
+    printf("Tests passed!\n");
+  else
+    printf("Test(s) failed!\n");
+
+  mman_print_info();
+  return ret;
+}
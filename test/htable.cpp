@@ -0,0 +1,546 @@
+#include <stdio.h>
+#include <blvckstd/htable.h>
+#include <blvckstd/hmap.h>
+#include <blvckstd/lru.h>
+#include <blvckstd/bloom.h>
+#include <blvckstd/tpool.h>
+
+#define EXIT_TEST_FAILURE(varname, retv)                              \
+  {                                                                   \
+    const char *rets = htable_result_name(retv);                      \
+    printf(varname " didn't match the expected value! (%s)\n", rets); \
+    return 1;                                                         \
+  }
+
+#define TEST_KEYS 5000
+
+int test_freeze()
+{
+  scptr htable_t *table = htable_make(TEST_KEYS, mman_dealloc_nr);
+
+  // Fill with string values equal to their keys
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%d", i);
+    htable_result_t ret = htable_insert(table, key, mman_ref(key));
+    if (ret != HTABLE_SUCCESS)
+      EXIT_TEST_FAILURE("insert", ret);
+  }
+
+  htable_result_t freeze_ret = htable_freeze(table);
+  if (freeze_ret != HTABLE_SUCCESS)
+    EXIT_TEST_FAILURE("freeze", freeze_ret);
+
+  // Every key has to be found on it's single probe
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%d", i);
+    char *value = NULL;
+    htable_result_t ret = htable_fetch(table, key, (void **) &value);
+    if (ret != HTABLE_SUCCESS || strcmp(key, value) != 0)
+      EXIT_TEST_FAILURE("frozen fetch", ret);
+  }
+
+  // Misses
+  if (htable_contains(table, "key--1"))
+    EXIT_TEST_FAILURE("frozen contains", HTABLE_SUCCESS);
+
+  // Read-only
+  htable_result_t insert_ret = htable_insert(table, "new", (void *) "new");
+  if (insert_ret != HTABLE_FROZEN)
+    EXIT_TEST_FAILURE("frozen insert", insert_ret);
+
+  scptr char **keys = NULL;
+  if (htable_list_keys(table, &keys) != TEST_KEYS)
+    EXIT_TEST_FAILURE("frozen list keys", HTABLE_SUCCESS);
+
+  // Duplicate keys can never be separated, which has to be detected up front
+  scptr htable_t *dups = htable_make_u64(TEST_KEYS, NULL);
+  for (int i = 0; i < TEST_KEYS; i++)
+    htable_insert_u64(dups, i % 2, (void *) 1);
+
+  freeze_ret = htable_freeze(dups);
+  if (freeze_ret != HTABLE_NO_PERFECT_HASH || htable_is_frozen(dups))
+    EXIT_TEST_FAILURE("freeze duplicates", freeze_ret);
+
+  return 0;
+}
+
+int test_fetch_many()
+{
+  scptr htable_t *table = htable_make(TEST_KEYS, NULL);
+
+  // Even numbers are inserted, odd numbers are missing
+  const char *keys[TEST_KEYS];
+  scptr char *key_buf = (char *) mman_alloc(sizeof(char), TEST_KEYS * 16, NULL);
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    keys[i] = &key_buf[i * 16];
+    sprintf(&key_buf[i * 16], "key-%d", i);
+    if (i % 2 == 0) htable_insert(table, keys[i], (void *) keys[i]);
+  }
+
+  // Check on the mutable as well as the frozen table
+  for (int frozen = 0; frozen < 2; frozen++)
+  {
+    if (frozen) htable_freeze(table);
+
+    void *values[TEST_KEYS];
+    if (htable_fetch_many(table, keys, TEST_KEYS, values) != TEST_KEYS / 2)
+      EXIT_TEST_FAILURE("fetch many count", HTABLE_SUCCESS);
+
+    bool exists[TEST_KEYS];
+    if (htable_contains_many(table, keys, TEST_KEYS, exists) != TEST_KEYS / 2)
+      EXIT_TEST_FAILURE("contains many count", HTABLE_SUCCESS);
+
+    for (int i = 0; i < TEST_KEYS; i++)
+    {
+      bool expected = i % 2 == 0;
+      if (exists[i] != expected || (expected ? values[i] != keys[i] : values[i] != NULL))
+        EXIT_TEST_FAILURE("fetch many value", HTABLE_KEY_NOT_FOUND);
+    }
+  }
+
+  return 0;
+}
+
+int test_typed_keys()
+{
+  // Integer keys, also across a freeze
+  scptr htable_t *ints = htable_make_u64(TEST_KEYS, NULL);
+  for (uint64_t i = 0; i < TEST_KEYS; i++)
+    htable_insert_u64(ints, i * 7919, (void *) (i + 1));
+
+  htable_result_t mismatch_ret = htable_insert(ints, "key", (void *) "key");
+  if (mismatch_ret != HTABLE_KEY_TYPE_MISMATCH)
+    EXIT_TEST_FAILURE("integer table string insert", mismatch_ret);
+
+  // Removing the first and the last link of chains
+  htable_result_t remove_ret = htable_remove_u64(ints, 0);
+  if (remove_ret != HTABLE_SUCCESS || htable_contains_u64(ints, 0))
+    EXIT_TEST_FAILURE("remove u64", remove_ret);
+
+  for (int frozen = 0; frozen < 2; frozen++)
+  {
+    if (frozen) htable_freeze(ints);
+
+    for (uint64_t i = 1; i < TEST_KEYS; i++)
+    {
+      void *value = NULL;
+      htable_result_t ret = htable_fetch_u64(ints, i * 7919, &value);
+      if (ret != HTABLE_SUCCESS || value != (void *) (i + 1))
+        EXIT_TEST_FAILURE("fetch u64", ret);
+    }
+
+    if (htable_contains_u64(ints, 1))
+      EXIT_TEST_FAILURE("contains u64", HTABLE_SUCCESS);
+  }
+
+  // Byte spans with embedded zeros, strings equal spans of their characters
+  scptr htable_t *bins = htable_make(16, NULL);
+  const char span_a[] = { 'a', 0, 'b' }, span_b[] = { 'a', 0, 'c' };
+  htable_insert_bin(bins, span_a, sizeof(span_a), (void *) span_a);
+  htable_insert_bin(bins, span_b, sizeof(span_b), (void *) span_b);
+  htable_insert(bins, "a", (void *) "a");
+
+  void *value = NULL;
+  htable_result_t bin_ret = htable_fetch_bin(bins, span_b, sizeof(span_b), &value);
+  if (bin_ret != HTABLE_SUCCESS || value != span_b)
+    EXIT_TEST_FAILURE("fetch bin", bin_ret);
+
+  bin_ret = htable_fetch_bin(bins, "a", 1, &value);
+  if (bin_ret != HTABLE_SUCCESS || strcmp((char *) value, "a") != 0)
+    EXIT_TEST_FAILURE("fetch bin string", bin_ret);
+
+  return 0;
+}
+
+int test_hmap()
+{
+  blvckstd::hmap<uint64_t, double> map(TEST_KEYS);
+
+  for (uint64_t i = 0; i < TEST_KEYS; i++)
+  {
+    htable_result_t ret = map.insert(i, i / 2.0);
+    if (ret != HTABLE_SUCCESS)
+      EXIT_TEST_FAILURE("hmap insert", ret);
+  }
+
+  htable_result_t full_ret = map.insert(TEST_KEYS, 0);
+  if (full_ret != HTABLE_FULL)
+    EXIT_TEST_FAILURE("hmap full", full_ret);
+
+  // Remove every third key, which shifts back the following entries
+  for (uint64_t i = 0; i < TEST_KEYS; i += 3)
+    map.remove(i);
+
+  for (uint64_t i = 0; i < TEST_KEYS; i++)
+  {
+    double *value = NULL;
+    htable_result_t ret = map.fetch(i, &value);
+    bool expected = i % 3 != 0;
+
+    if (expected != (ret == HTABLE_SUCCESS) || (expected && *value != i / 2.0))
+      EXIT_TEST_FAILURE("hmap fetch", ret);
+  }
+
+  blvckstd::hmap<const char *, int> strs(4);
+  strs.insert("a", 1);
+  scptr char *key = strfmt_direct("a");
+  if (!strs.contains(key) || strs.insert(key, 2) != HTABLE_KEY_ALREADY_EXISTS)
+    EXIT_TEST_FAILURE("hmap string key", HTABLE_KEY_NOT_FOUND);
+
+  return 0;
+}
+
+static size_t lru_evictions = 0;
+
+static void lru_count_eviction(void *value)
+{
+  lru_evictions++;
+}
+
+int test_lru()
+{
+  scptr lru_t *cache = lru_make(3, 10, mman_dealloc_nr, lru_count_eviction);
+
+  lru_put(cache, "a", strfmt_direct("a"), 2, 0);
+  lru_put(cache, "b", strfmt_direct("b"), 2, 0);
+  lru_put(cache, "c", strfmt_direct("c"), 2, 0);
+
+  // Touch a, so that b becomes the least recently used entry
+  void *value = NULL;
+  if (lru_get(cache, "a", &value) != LRU_SUCCESS)
+    EXIT_TEST_FAILURE("lru get", HTABLE_KEY_NOT_FOUND);
+
+  // Entry limit evicts b
+  lru_put(cache, "d", strfmt_direct("d"), 2, 0);
+  if (lru_get(cache, "b", &value) != LRU_KEY_NOT_FOUND || lru_evictions != 1)
+    EXIT_TEST_FAILURE("lru entry limit", HTABLE_SUCCESS);
+
+  // Entry limit evicts c, byte limit evicts a
+  lru_put(cache, "e", strfmt_direct("e"), 7, 0);
+  if (lru_count(cache) != 2 || lru_evictions != 3 || lru_get(cache, "d", &value) != LRU_SUCCESS)
+    EXIT_TEST_FAILURE("lru byte limit", HTABLE_SUCCESS);
+
+  // Zero TTL never expires, an already passed one does
+  lru_put(cache, "f", strfmt_direct("f"), 1, 0);
+  cache->_head->expires_at = 1;
+  if (lru_get(cache, "f", &value) != LRU_EXPIRED || lru_evictions != 4)
+    EXIT_TEST_FAILURE("lru ttl", HTABLE_SUCCESS);
+
+  // Without an entry limit, only the byte limit evicts
+  scptr lru_t *bytes_only = lru_make(0, 500, mman_dealloc_nr, NULL);
+  for (int i = 0; i < 1000; i++)
+  {
+    scptr char *key = strfmt_direct("%d", i);
+    if (lru_put(bytes_only, key, strfmt_direct("%d", i), 1, 0) != LRU_SUCCESS)
+      EXIT_TEST_FAILURE("lru bytes only put", HTABLE_SUCCESS);
+  }
+
+  if (lru_count(bytes_only) != 500 || lru_get(bytes_only, "999", &value) != LRU_SUCCESS)
+    EXIT_TEST_FAILURE("lru bytes only", HTABLE_SUCCESS);
+
+  return 0;
+}
+
+int test_stats()
+{
+  scptr htable_t *table = htable_make(64, NULL);
+  for (uint64_t i = 0; i < 64; i++)
+    htable_insert_bin(table, &i, sizeof(i), (void *) (i + 1));
+
+  htable_stats_t stats;
+  htable_stats(table, &stats);
+
+  // Every item has to show up in the histogram
+  size_t items = 0;
+  for (size_t l = 0; l < HTABLE_STATS_HIST_LEN; l++)
+    items += stats.chain_hist[l] * l;
+
+  if (
+    stats.slot_count != 10 || stats.item_count != 64
+    || (stats.max_chain < HTABLE_STATS_HIST_LEN && items != 64)
+    || stats.avg_probes < 1.0 || stats.load_factor != 6.4
+  )
+    EXIT_TEST_FAILURE("stats", HTABLE_SUCCESS);
+
+  // Lookups are only counted while enabled
+  if (stats.lookups != 0 || stats.probes != 0)
+    EXIT_TEST_FAILURE("disabled probe stats", HTABLE_SUCCESS);
+
+  htable_set_probe_stats(table, true);
+  for (size_t i = 0; i < 64; i++)
+    htable_contains_bin(table, &i, sizeof(i));
+
+  htable_stats(table, &stats);
+  if (stats.lookups != 64 || stats.probes < 64)
+    EXIT_TEST_FAILURE("probe stats", HTABLE_SUCCESS);
+
+  htable_freeze(table);
+  htable_stats(table, &stats);
+  if (stats.max_chain != 1 || stats.avg_probes != 1.0)
+    EXIT_TEST_FAILURE("frozen stats", HTABLE_SUCCESS);
+
+  return 0;
+}
+
+int test_snapshot()
+{
+  const char *path = "htable_snapshot.bin";
+  scptr htable_t *table = htable_make(TEST_KEYS, mman_dealloc_nr);
+
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%d", i);
+    htable_insert(table, key, strfmt_direct("value-%d", i));
+  }
+
+  htable_result_t save_ret = htable_save(table, path, NULL);
+  if (save_ret != HTABLE_SUCCESS)
+    EXIT_TEST_FAILURE("save", save_ret);
+
+  scptr htable_mapped_t *mapped = htable_map(path);
+  remove(path);
+  if (!mapped)
+    EXIT_TEST_FAILURE("map", HTABLE_IO_ERROR);
+
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%d", i);
+    scptr char *expected = strfmt_direct("value-%d", i);
+
+    const void *value = NULL;
+    size_t size = 0;
+    htable_result_t ret = htable_mapped_fetch(mapped, key, &value, &size);
+    if (ret != HTABLE_SUCCESS || size != strlen(expected) + 1 || strcmp((char *) value, expected) != 0)
+      EXIT_TEST_FAILURE("mapped fetch", ret);
+  }
+
+  const void *value = NULL;
+  if (htable_mapped_fetch(mapped, "key--1", &value, NULL) != HTABLE_KEY_NOT_FOUND)
+    EXIT_TEST_FAILURE("mapped miss", HTABLE_SUCCESS);
+
+  return 0;
+}
+
+int test_shrink()
+{
+  scptr htable_t *table = htable_make_u64(TEST_KEYS, NULL);
+  htable_set_shrink_threshold(table, 0.25);
+
+  for (uint64_t i = 0; i < TEST_KEYS; i++)
+    htable_insert_u64(table, i, (void *) (i + 1));
+
+  // Removing all but a few keys shrinks the slots
+  for (uint64_t i = 0; i < TEST_KEYS - 12; i++)
+    htable_remove_u64(table, i);
+
+  // Left at half the designed load
+  if (table->_slot_count != 2 * 12 / HTABLE_ITEMS_PER_SLOT || table->_item_count != 12)
+    EXIT_TEST_FAILURE("auto shrink", HTABLE_SUCCESS);
+
+  for (uint64_t i = TEST_KEYS - 12; i < TEST_KEYS; i++)
+  {
+    void *value = NULL;
+    htable_result_t ret = htable_fetch_u64(table, i, &value);
+    if (ret != HTABLE_SUCCESS || value != (void *) (i + 1))
+      EXIT_TEST_FAILURE("shrunk fetch", ret);
+  }
+
+  // Refilling grows the slots back to their designed count
+  for (uint64_t i = 0; i < TEST_KEYS - 12; i++)
+    htable_insert_u64(table, i, (void *) (i + 1));
+
+  if (table->_slot_count != TEST_KEYS / HTABLE_ITEMS_PER_SLOT)
+    EXIT_TEST_FAILURE("regrow", HTABLE_SUCCESS);
+
+  htable_set_shrink_threshold(table, 0);
+  for (uint64_t i = 0; i < TEST_KEYS * 3 / 4; i++)
+    htable_remove_u64(table, i);
+
+  htable_result_t ret = htable_shrink_to_fit(table);
+  if (ret != HTABLE_SUCCESS || table->_slot_count != 2 * (TEST_KEYS / 4) / HTABLE_ITEMS_PER_SLOT)
+    EXIT_TEST_FAILURE("shrink to fit", ret);
+
+  return 0;
+}
+
+int test_shrink_churn()
+{
+  scptr htable_t *table = htable_make_u64(TEST_KEYS, NULL);
+
+  // Thresholds get clamped, so that shrinking can't undo the headroom it leaves
+  htable_set_shrink_threshold(table, 0.9);
+  if (table->_shrink_threshold != HTABLE_MAX_SHRINK_THRESHOLD)
+    EXIT_TEST_FAILURE("shrink threshold clamp", HTABLE_SUCCESS);
+
+  for (uint64_t i = 0; i < TEST_KEYS; i++)
+    htable_insert_u64(table, i, (void *) (i + 1));
+
+  // Remove up to the first shrink
+  uint64_t next = 0;
+  size_t designed = table->_slot_count;
+  while (table->_slot_count == designed)
+    htable_remove_u64(table, next++);
+
+  // Alternating around the boundary doesn't resize in either direction
+  size_t shrunk = table->_slot_count;
+  for (size_t i = 0; i < TEST_KEYS; i++)
+  {
+    htable_insert_u64(table, next - 1, (void *) next);
+    if (table->_slot_count != shrunk)
+      EXIT_TEST_FAILURE("churn insert", HTABLE_SUCCESS);
+
+    htable_remove_u64(table, next - 1);
+    if (table->_slot_count != shrunk)
+      EXIT_TEST_FAILURE("churn remove", HTABLE_SUCCESS);
+  }
+
+  return 0;
+}
+
+int test_unbounded()
+{
+  scptr htable_t *table = htable_make_unbounded(4, NULL);
+
+  // Grows past it's initial size without ever running full
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%d", i);
+    htable_result_t ret = htable_insert(table, key, (void *) (uintptr_t) (i + 1));
+    if (ret != HTABLE_SUCCESS)
+      EXIT_TEST_FAILURE("unbounded insert", ret);
+  }
+
+  if (table->_slot_count < TEST_KEYS / HTABLE_ITEMS_PER_SLOT)
+    EXIT_TEST_FAILURE("unbounded growth", HTABLE_SUCCESS);
+
+  return 0;
+}
+
+static void *test_clone_ref(void *value)
+{
+  return mman_ref(value);
+}
+
+int test_append_parallel()
+{
+  scptr tpool_t *pool = tpool_make(4);
+
+  // Overlapping key ranges, the source's values are prefixed
+  scptr htable_t *dest = htable_make(TEST_KEYS, mman_dealloc_nr);
+  scptr htable_t *src = htable_make(TEST_KEYS, mman_dealloc_nr);
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%d", i);
+    if (i < TEST_KEYS / 2) htable_insert(dest, key, mman_ref(key));
+    if (i >= TEST_KEYS / 4) htable_insert(src, key, strfmt_direct("src-%s", key));
+  }
+
+  htable_result_t ret = htable_append_table_parallel(dest, src, HTABLE_AM_DUPERR, test_clone_ref, pool);
+  if (ret != HTABLE_KEY_ALREADY_EXISTS || dest->_item_count != TEST_KEYS / 2)
+    EXIT_TEST_FAILURE("parallel append duperr", ret);
+
+  ret = htable_append_table_parallel(dest, src, HTABLE_AM_SKIP, test_clone_ref, pool);
+  if (ret != HTABLE_SUCCESS || dest->_item_count != TEST_KEYS)
+    EXIT_TEST_FAILURE("parallel append skip", ret);
+
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%d", i);
+    char *value = NULL;
+    htable_fetch(dest, key, (void **) &value);
+    if (!value || (i < TEST_KEYS / 2) != (strcmp(key, value) == 0))
+      EXIT_TEST_FAILURE("parallel append skip fetch", HTABLE_SUCCESS);
+  }
+
+  ret = htable_append_table_parallel(dest, src, HTABLE_AM_OVERRIDE, test_clone_ref, pool);
+  if (ret != HTABLE_SUCCESS || dest->_item_count != TEST_KEYS)
+    EXIT_TEST_FAILURE("parallel append override", ret);
+
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%d", i);
+    char *value = NULL;
+    htable_fetch(dest, key, (void **) &value);
+    if (!value || (i < TEST_KEYS / 4) != (strcmp(key, value) == 0))
+      EXIT_TEST_FAILURE("parallel append override fetch", HTABLE_SUCCESS);
+  }
+
+  return 0;
+}
+
+int test_bloom()
+{
+  scptr bloom_t *bloom = bloom_make(TEST_KEYS, 10);
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%d", i);
+    bloom_add(bloom, key);
+  }
+
+  // No false negatives, about 1% false positives
+  size_t false_positives = 0;
+  for (int i = 0; i < TEST_KEYS; i++)
+  {
+    scptr char *key = strfmt_direct("key-%d", i);
+    scptr char *miss = strfmt_direct("miss-%d", i);
+
+    if (!bloom_may_contain(bloom, key))
+      EXIT_TEST_FAILURE("bloom false negative", HTABLE_SUCCESS);
+
+    if (bloom_may_contain(bloom, miss)) false_positives++;
+  }
+
+  if (false_positives > TEST_KEYS / 20)
+    EXIT_TEST_FAILURE("bloom false positives", HTABLE_SUCCESS);
+
+  // Attached filters are filled with existing keys and follow insertions
+  scptr htable_t *table = htable_make(TEST_KEYS, NULL);
+  htable_insert(table, "before", (void *) "before");
+  htable_attach_bloom(table, 10);
+  htable_insert(table, "after", (void *) "after");
+
+  const char *keys[] = { "before", "after", "missing" };
+  void *values[3];
+  if (
+    !htable_contains(table, "before") || !htable_contains(table, "after")
+    || htable_contains(table, "missing")
+    || htable_fetch_many(table, keys, 3, values) != 2 || values[2] != NULL
+  )
+    EXIT_TEST_FAILURE("attached bloom", HTABLE_SUCCESS);
+
+  return 0;
+}
+
+int proc()
+{
+  int ret;
+  if ((ret = test_freeze()) != 0) return ret;
+  if ((ret = test_fetch_many()) != 0) return ret;
+  if ((ret = test_typed_keys()) != 0) return ret;
+  if ((ret = test_hmap()) != 0) return ret;
+  if ((ret = test_lru()) != 0) return ret;
+  if ((ret = test_stats()) != 0) return ret;
+  if ((ret = test_snapshot()) != 0) return ret;
+  if ((ret = test_shrink()) != 0) return ret;
+  if ((ret = test_shrink_churn()) != 0) return ret;
+  if ((ret = test_unbounded()) != 0) return ret;
+  if ((ret = test_append_parallel()) != 0) return ret;
+  if ((ret = test_bloom()) != 0) return ret;
+  return 0;
+}
+
+int main()
+{
+  int ret = proc();
+
+  if (ret == 0)
+    printf("Tests passed!\n");
+  else
+    printf("Test(s) failed!\n");
+
+  mman_print_info();
+  return ret;
+}
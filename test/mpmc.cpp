@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <pthread.h>
+#include <blvckstd/mpmc.h>
+
+#define EXIT_TEST_FAILURE(varname)                              \
+  {                                                             \
+    printf(varname " didn't match the expected value!\n");      \
+    return 1;                                                   \
+  }
+
+#define TEST_THREADS 4
+#define TEST_ITEMS 100000
+#define TEST_BATCH 16
+
+typedef struct
+{
+  mpmc_t *queue;
+  size_t id;
+  size_t sum;
+} test_worker_t;
+
+static void *test_producer(void *arg)
+{
+  test_worker_t *worker = (test_worker_t *) arg;
+
+  // Each producer pushes a disjoint range of values
+  for (size_t i = 1; i <= TEST_ITEMS; i++)
+  {
+    size_t value = worker->id * TEST_ITEMS + i;
+    mpmc_push(worker->queue, &value);
+  }
+
+  return NULL;
+}
+
+static void *test_consumer(void *arg)
+{
+  test_worker_t *worker = (test_worker_t *) arg;
+
+  for (size_t i = 0; i < TEST_ITEMS; i++)
+  {
+    size_t value;
+    mpmc_pop(worker->queue, &value);
+    worker->sum += value;
+  }
+
+  return NULL;
+}
+
+static void *test_batch_producer(void *arg)
+{
+  test_worker_t *worker = (test_worker_t *) arg;
+
+  size_t values[TEST_BATCH];
+  for (size_t i = 1; i <= TEST_ITEMS;)
+  {
+    size_t count = 0;
+    for (; count < TEST_BATCH && i + count <= TEST_ITEMS; count++)
+      values[count] = worker->id * TEST_ITEMS + i + count;
+
+    i += mpmc_try_push_n(worker->queue, values, count);
+  }
+
+  return NULL;
+}
+
+static void *test_batch_consumer(void *arg)
+{
+  test_worker_t *worker = (test_worker_t *) arg;
+
+  size_t values[TEST_BATCH];
+  for (size_t i = 0; i < TEST_ITEMS;)
+  {
+    size_t count = TEST_ITEMS - i < TEST_BATCH ? TEST_ITEMS - i : TEST_BATCH;
+    size_t popped = mpmc_try_pop_n(worker->queue, values, count);
+
+    for (size_t j = 0; j < popped; j++)
+      worker->sum += values[j];
+
+    i += popped;
+  }
+
+  return NULL;
+}
+
+int test_single()
+{
+  scptr mpmc_t *queue = mpmc_make(5, sizeof(size_t), NULL);
+
+  // Capacity got rounded up to eight
+  size_t values[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+  if (mpmc_try_push_n(queue, values, 10) != 8 || mpmc_length(queue) != 8)
+    EXIT_TEST_FAILURE("push_n");
+
+  size_t value = 11;
+  if (mpmc_try_push(queue, &value))
+    EXIT_TEST_FAILURE("push full");
+
+  // Items come out in FIFO order
+  size_t out[10];
+  if (mpmc_try_pop_n(queue, out, 3) != 3 || out[0] != 1 || out[2] != 3)
+    EXIT_TEST_FAILURE("pop_n");
+
+  if (!mpmc_try_push_n(queue, &value, 1))
+    EXIT_TEST_FAILURE("push wrapped");
+
+  if (mpmc_try_pop_n(queue, out, 10) != 6 || out[4] != 8 || out[5] != 11)
+    EXIT_TEST_FAILURE("pop wrapped");
+
+  if (mpmc_try_pop(queue, &value) || mpmc_length(queue) != 0)
+    EXIT_TEST_FAILURE("pop empty");
+
+  return 0;
+}
+
+int test_pointers()
+{
+  scptr mpmc_t *queue = mpmc_make(16, sizeof(void *), NULL);
+
+  char *first = (char *) "first";
+  if (!mpmc_try_push(queue, &first))
+    EXIT_TEST_FAILURE("push pointer");
+
+  char *out = NULL;
+  if (!mpmc_try_pop(queue, &out) || out != first)
+    EXIT_TEST_FAILURE("pop pointer");
+
+  return 0;
+}
+
+int test_concurrent(void *(*producer)(void *), void *(*consumer)(void *))
+{
+  // Small enough to keep both sides waiting on each other
+  scptr mpmc_t *queue = mpmc_make(64, sizeof(size_t), NULL);
+
+  test_worker_t producers[TEST_THREADS], consumers[TEST_THREADS];
+  pthread_t threads[TEST_THREADS * 2];
+
+  for (size_t i = 0; i < TEST_THREADS; i++)
+  {
+    producers[i] = { queue, i, 0 };
+    consumers[i] = { queue, i, 0 };
+    pthread_create(&threads[i], NULL, producer, &producers[i]);
+    pthread_create(&threads[TEST_THREADS + i], NULL, consumer, &consumers[i]);
+  }
+
+  size_t sum = 0;
+  for (size_t i = 0; i < TEST_THREADS * 2; i++)
+    pthread_join(threads[i], NULL);
+
+  for (size_t i = 0; i < TEST_THREADS; i++)
+    sum += consumers[i].sum;
+
+  // Every value has been popped exactly once
+  size_t n = TEST_THREADS * TEST_ITEMS;
+  if (sum != n * (n + 1) / 2 || mpmc_length(queue) != 0)
+    EXIT_TEST_FAILURE("concurrent sum");
+
+  return 0;
+}
+
+int proc()
+{
+  int ret;
+  if ((ret = test_single()) != 0) return ret;
+  if ((ret = test_pointers()) != 0) return ret;
+  if ((ret = test_concurrent(test_producer, test_consumer)) != 0) return ret;
+  if ((ret = test_concurrent(test_batch_producer, test_batch_consumer)) != 0) return ret;
+  return 0;
+}
+
+int main()
+{
+  int ret = proc();
+
+  if (ret == 0)
+    printf("Tests passed!\n");
+  else
+    printf("Test(s) failed!\n");
+
+  mman_print_info();
+  return ret;
+}
@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <blvckstd/pqueue.h>
+#include <blvckstd/twheel.h>
+
+#define EXIT_TEST_FAILURE(varname, retv)                              \
+  {                                                                   \
+    const char *rets = pqueue_result_name(retv);                      \
+    printf(varname " didn't match the expected value! (%s)\n", rets); \
+    return 1;                                                         \
+  }
+
+#define TEST_ITEMS 10000
+#define TEST_TIMERS 10000
+
+static int test_cmp(const void *a, const void *b)
+{
+  size_t x = *(size_t *) a, y = *(size_t *) b;
+  return (x > y) - (x < y);
+}
+
+int test_pqueue()
+{
+  scptr pqueue_t *pq = pqueue_make(4, TEST_ITEMS, test_cmp, NULL);
+  scptr size_t *prios = (size_t *) mman_alloc(sizeof(size_t), TEST_ITEMS, NULL);
+  scptr size_t *handles = (size_t *) mman_alloc(sizeof(size_t), TEST_ITEMS, NULL);
+
+  srand(42);
+  for (size_t i = 0; i < TEST_ITEMS; i++)
+  {
+    prios[i] = rand() % 100000 + 1000;
+    pqueue_result_t ret = pqueue_push(pq, &prios[i], &handles[i]);
+    if (ret != PQUEUE_SUCCESS)
+      EXIT_TEST_FAILURE("pqueue push", ret);
+  }
+
+  pqueue_result_t ret = pqueue_push(pq, &prios[0], NULL);
+  if (ret != PQUEUE_FULL)
+    EXIT_TEST_FAILURE("pqueue full", ret);
+
+  // A cap below the initial size still holds the one item that's always allocated
+  scptr pqueue_t *tiny = pqueue_make(4, 0, test_cmp, NULL);
+  if ((ret = pqueue_push(tiny, &prios[0], NULL)) != PQUEUE_SUCCESS)
+    EXIT_TEST_FAILURE("pqueue tiny push", ret);
+
+  if ((ret = pqueue_push(tiny, &prios[1], NULL)) != PQUEUE_FULL || tiny->_array_size != 1)
+    EXIT_TEST_FAILURE("pqueue tiny full", ret);
+
+  // Raise the priority of every tenth item to the front
+  for (size_t i = 0; i < TEST_ITEMS; i += 10)
+  {
+    prios[i] = i / 10;
+    if ((ret = pqueue_decrease_key(pq, handles[i])) != PQUEUE_SUCCESS)
+      EXIT_TEST_FAILURE("pqueue decrease_key", ret);
+  }
+
+  // Lower the priority of every tenth but one to the back
+  for (size_t i = 1; i < TEST_ITEMS; i += 10)
+  {
+    prios[i] = 200000;
+    if ((ret = pqueue_update(pq, handles[i])) != PQUEUE_SUCCESS)
+      EXIT_TEST_FAILURE("pqueue update", ret);
+  }
+
+  // Remove every tenth but two
+  for (size_t i = 2; i < TEST_ITEMS; i += 10)
+  {
+    void *removed;
+    if ((ret = pqueue_remove(pq, handles[i], &removed)) != PQUEUE_SUCCESS || removed != &prios[i])
+      EXIT_TEST_FAILURE("pqueue remove", ret);
+  }
+
+  if ((ret = pqueue_remove(pq, handles[2], NULL)) != PQUEUE_INVALID_HANDLE)
+    EXIT_TEST_FAILURE("pqueue stale remove", ret);
+
+  // Items come out in order
+  size_t prev = 0, count = 0;
+  void *item;
+  while (pqueue_pop(pq, &item) == PQUEUE_SUCCESS)
+  {
+    size_t prio = *(size_t *) item;
+    if (prio < prev || (count < TEST_ITEMS / 10 && prio != count))
+      EXIT_TEST_FAILURE("pqueue order", PQUEUE_SUCCESS);
+
+    prev = prio;
+    count++;
+  }
+
+  if (count != TEST_ITEMS - TEST_ITEMS / 10 || pqueue_peek(pq))
+    EXIT_TEST_FAILURE("pqueue count", PQUEUE_SUCCESS);
+
+  return 0;
+}
+
+typedef struct
+{
+  twheel_t *wheel;
+  uint64_t expected;
+  uint64_t fired;
+  twheel_timer_t timer;
+} test_timer_t;
+
+static void test_fire(void *arg)
+{
+  test_timer_t *t = (test_timer_t *) arg;
+  t->fired = t->wheel->_now;
+}
+
+int test_twheel()
+{
+  scptr twheel_t *wheel = twheel_make(1000);
+  scptr test_timer_t *timers = (test_timer_t *) mman_alloc(sizeof(test_timer_t), TEST_TIMERS, NULL);
+
+  // Spread delays across all levels and beyond
+  srand(42);
+  for (size_t i = 0; i < TEST_TIMERS; i++)
+  {
+    test_timer_t *t = &timers[i];
+    uint64_t delay = (uint64_t) rand() % ((uint64_t) 1 << (i % 26)) + 1;
+
+    t->wheel = wheel;
+    t->expected = 1000 + delay;
+    t->fired = 0;
+    twheel_timer_init(&t->timer, test_fire, t);
+    twheel_schedule(wheel, &t->timer, delay);
+  }
+
+  // Cancel every third timer
+  for (size_t i = 0; i < TEST_TIMERS; i += 3)
+  {
+    if (!twheel_cancel(wheel, &timers[i].timer) || twheel_pending(&timers[i].timer))
+      EXIT_TEST_FAILURE("twheel cancel", PQUEUE_SUCCESS);
+  }
+
+  if (twheel_cancel(wheel, &timers[0].timer))
+    EXIT_TEST_FAILURE("twheel double cancel", PQUEUE_SUCCESS);
+
+  // Advance in uneven steps
+  size_t fired = 0;
+  for (uint64_t now = 1000; twheel_length(wheel); now += 7919)
+    fired += twheel_advance(wheel, now);
+
+  if (fired != TEST_TIMERS - (TEST_TIMERS + 2) / 3)
+    EXIT_TEST_FAILURE("twheel fired", PQUEUE_SUCCESS);
+
+  // Every timer fired on it's exact tick
+  for (size_t i = 0; i < TEST_TIMERS; i++)
+  {
+    uint64_t expected = i % 3 == 0 ? 0 : timers[i].expected;
+    if (timers[i].fired != expected)
+      EXIT_TEST_FAILURE("twheel tick", PQUEUE_SUCCESS);
+  }
+
+  // Timers left pending are detached once the wheel goes away
+  twheel_t *dropped = twheel_make(0);
+  twheel_schedule(dropped, &timers[0].timer, 5);
+  mman_dealloc(dropped);
+
+  if (twheel_pending(&timers[0].timer))
+    EXIT_TEST_FAILURE("twheel cleanup", PQUEUE_SUCCESS);
+
+  return 0;
+}
+
+int proc()
+{
+  int ret;
+  if ((ret = test_pqueue()) != 0) return ret;
+  if ((ret = test_twheel()) != 0) return ret;
+  return 0;
+}
+
+int main()
+{
+  int ret = proc();
+
+  if (ret == 0)
+    printf("Tests passed!\n");
+  else
+    printf("Test(s) failed!\n");
+
+  mman_print_info();
+  return ret;
+}
@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <blvckstd/tpool.h>
+
+#define EXIT_TEST_FAILURE(varname)                              \
+  {                                                             \
+    printf(varname " didn't match the expected value!\n");      \
+    return 1;                                                   \
+  }
+
+#define TEST_THREADS 4
+#define TEST_ITEMS 1000000
+#define TEST_DEPTH 14
+
+static void test_square(void *arg, size_t from, size_t to)
+{
+  size_t *values = (size_t *) arg;
+  for (size_t i = from; i < to; i++)
+    values[i] = i * i;
+}
+
+typedef struct
+{
+  tpool_t *pool;
+  size_t depth;
+  volatile size_t *leaves;
+} test_tree_t;
+
+static void test_tree(void *arg)
+{
+  test_tree_t *node = (test_tree_t *) arg;
+  if (node->depth == 0)
+  {
+    atomic_increment(node->leaves);
+    return;
+  }
+
+  // Split up into two subtrees and wait on both of them
+  tpool_wait_t wg;
+  tpool_wait_init(&wg);
+
+  test_tree_t children[2];
+  for (size_t i = 0; i < 2; i++)
+  {
+    children[i] = { node->pool, node->depth - 1, node->leaves };
+    tpool_submit(node->pool, test_tree, &children[i], &wg);
+  }
+
+  tpool_wait(node->pool, &wg);
+}
+
+static void test_count(void *arg)
+{
+  atomic_increment((volatile size_t *) arg);
+}
+
+int test_parallel_for()
+{
+  scptr tpool_t *pool = tpool_make(TEST_THREADS);
+  scptr size_t *values = (size_t *) mman_calloc(sizeof(size_t), TEST_ITEMS, NULL);
+
+  tpool_parallel_for(pool, 0, TEST_ITEMS, 0, test_square, values);
+  for (size_t i = 0; i < TEST_ITEMS; i++)
+    if (values[i] != i * i)
+      EXIT_TEST_FAILURE("parallel_for");
+
+  // Uneven grain, the last chunk is partial
+  tpool_parallel_for(pool, 10, 1010, 333, test_square, values);
+  if (values[1009] != 1009 * 1009)
+    EXIT_TEST_FAILURE("parallel_for grain");
+
+  return 0;
+}
+
+int test_nested()
+{
+  scptr tpool_t *pool = tpool_make(TEST_THREADS);
+
+  // Tasks submitting and awaiting further tasks must not deadlock
+  volatile size_t leaves = 0;
+  test_tree_t root = { pool, TEST_DEPTH, &leaves };
+  tpool_wait_t wg;
+  tpool_wait_init(&wg);
+  tpool_submit(pool, test_tree, &root, &wg);
+  tpool_wait(pool, &wg);
+
+  if (leaves != (1 << TEST_DEPTH))
+    EXIT_TEST_FAILURE("nested leaves");
+
+  return 0;
+}
+
+int test_cleanup()
+{
+  volatile size_t count = 0;
+
+  // Tasks without a wait group have all run once the pool is gone
+  {
+    scptr tpool_t *pool = tpool_make(TEST_THREADS);
+    for (size_t i = 0; i < TPOOL_INJECT_CAP * 2; i++)
+      tpool_submit(pool, test_count, (void *) &count, NULL);
+  }
+
+  if (count != TPOOL_INJECT_CAP * 2)
+    EXIT_TEST_FAILURE("cleanup count");
+
+  return 0;
+}
+
+int proc()
+{
+  int ret;
+  if ((ret = test_parallel_for()) != 0) return ret;
+  if ((ret = test_nested()) != 0) return ret;
+  if ((ret = test_cleanup()) != 0) return ret;
+  return 0;
+}
+
+int main()
+{
+  int ret = proc();
+
+  if (ret == 0)
+    printf("Tests passed!\n");
+  else
+    printf("Test(s) failed!\n");
+
+  mman_print_info();
+  return ret;
+}